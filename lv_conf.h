@@ -78,6 +78,16 @@
  *(Not so important, you can adjust it to modify default sizes and spaces)*/
 #define LV_DPI_DEF 130     /*[px/inch]*/
 
+/*Height of the two partial draw buffers used by the ST7735 driver (src/chef_lvgl).
+ *Both strips are allocated from DMA-capable memory; taller strips mean fewer flushes per frame.
+ *Choose it from the host benchmark, which times every screen at each height listed and
+ *suggests the smallest one within a few percent of the fastest:
+ *  pio run -e native && .pio/build/native/program --lines 8,10,16,20,32,40,80,160
+ *Override per build with -D CHEF_DRAW_BUF_LINES=N.*/
+#ifndef CHEF_DRAW_BUF_LINES
+#define CHEF_DRAW_BUF_LINES 20     /*[px]*/
+#endif
+
 /*=================
  * OPERATING SYSTEM
  *=================*/
@@ -1,31 +1,218 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include "driver/gpio.h"
-#include "rom/gpio.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
 #include "chef_button.h"
 #include "lvgl.h"
 #include "driver/ledc.h"
 
+#define BUTTON_EDGE_QUEUE_LEN  16
+#define BUTTON_EVENT_QUEUE_LEN 16
+#define BUTTON_TASK_STACK      3072
+#define BUTTON_TASK_PRIORITY   6
+#define BUTTON_TASK_CORE       0
+
+#define DEBOUNCE_US   (BUTTON_DEBOUNCE_MS * 1000LL)
+#define LONG_PRESS_US (BUTTON_LONG_PRESS_MS * 1000LL)
+#define REPEAT_DELAY_US (BUTTON_REPEAT_DELAY_MS * 1000LL)
+#define REPEAT_START_US (BUTTON_REPEAT_START_MS * 1000LL)
+#define REPEAT_MIN_US   (BUTTON_REPEAT_MIN_MS * 1000LL)
+#define NO_DEADLINE   INT64_MAX
+
+static const char *TAG = "BUTTONS";
+
+static const gpio_num_t button_pins[] = {BTN_NEXT, BTN_PREV, BTN_SELECT, BTN_UP, BTN_DOWN};
+#define BUTTON_COUNT (sizeof(button_pins) / sizeof(button_pins[0]))
+
+typedef struct {
+    uint8_t index;
+    int64_t time_us;
+} button_edge_t;
+
+typedef struct {
+    bool pressed;              // debounced state
+    int64_t last_change_us;    // time of the last accepted transition
+    int64_t settle_at_us;      // re-read the pin once the contacts have settled
+    int64_t long_press_at_us;
+    int64_t repeat_at_us;
+    int64_t repeat_interval_us;
+} button_state_t;
+
+static button_state_t buttons[BUTTON_COUNT];
+static QueueHandle_t edge_queue;    // ISR -> service task
+static QueueHandle_t event_queue;   // service task -> screens
+
+// Only timestamp the edge; the level is read by the service task
+static void IRAM_ATTR button_isr(void *arg) {
+    button_edge_t edge = {
+        .index = (uint8_t)(uintptr_t)arg,
+        .time_us = esp_timer_get_time(),
+    };
+    BaseType_t woken = pdFALSE;
+    xQueueSendFromISR(edge_queue, &edge, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static bool read_pressed(int index) {
+    return gpio_get_level(button_pins[index]) == 0;
+}
+
+static void publish(int index, chef_button_event_type_t type, int64_t time_us) {
+    chef_button_event_t event = {
+        .pin = button_pins[index],
+        .type = type,
+        .time_us = time_us,
+    };
+    if (xQueueSend(event_queue, &event, 0) != pdTRUE) {
+        ESP_LOGW(TAG, "Event queue full, dropping event for pin %d", button_pins[index]);
+    }
+}
+
+static void set_pressed(int index, bool pressed, int64_t time_us) {
+    button_state_t *b = &buttons[index];
+    b->pressed = pressed;
+    b->last_change_us = time_us;
+    b->long_press_at_us = pressed ? time_us + LONG_PRESS_US : NO_DEADLINE;
+    b->repeat_at_us = pressed ? time_us + REPEAT_DELAY_US : NO_DEADLINE;
+    b->repeat_interval_us = REPEAT_START_US;
+    publish(index, pressed ? CHEF_BUTTON_PRESS : CHEF_BUTTON_RELEASE, time_us);
+}
+
+// The first edge after a quiet period is reported at once. Edges inside the
+// debounce window are bounce: they only push back the settle check, which
+// catches a final level that differs from the one reported.
+static void handle_edge(const button_edge_t *edge) {
+    button_state_t *b = &buttons[edge->index];
+    bool pressed = read_pressed(edge->index);
+
+    if (pressed != b->pressed && edge->time_us - b->last_change_us >= DEBOUNCE_US) {
+        set_pressed(edge->index, pressed, edge->time_us);
+    }
+    b->settle_at_us = edge->time_us + DEBOUNCE_US;
+}
+
+static void handle_deadlines(int64_t now) {
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        button_state_t *b = &buttons[i];
+
+        if (b->settle_at_us <= now) {
+            b->settle_at_us = NO_DEADLINE;
+            bool pressed = read_pressed(i);
+            if (pressed != b->pressed) {
+                set_pressed(i, pressed, now);
+            }
+        }
+
+        if (b->long_press_at_us <= now) {
+            b->long_press_at_us = NO_DEADLINE;
+            if (b->pressed) {
+                publish(i, CHEF_BUTTON_LONG_PRESS, now);
+            }
+        }
+
+        if (b->repeat_at_us <= now) {
+            if (b->pressed) {
+                publish(i, CHEF_BUTTON_REPEAT, now);
+                // Schedule from now, so a late wake-up does not send a burst
+                b->repeat_at_us = now + b->repeat_interval_us;
+                b->repeat_interval_us -= b->repeat_interval_us / 4;
+                if (b->repeat_interval_us < REPEAT_MIN_US) {
+                    b->repeat_interval_us = REPEAT_MIN_US;
+                }
+            } else {
+                b->repeat_at_us = NO_DEADLINE;
+            }
+        }
+    }
+}
+
+static TickType_t ticks_until_deadline(int64_t now) {
+    int64_t next = NO_DEADLINE;
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        if (buttons[i].settle_at_us < next) {
+            next = buttons[i].settle_at_us;
+        }
+        if (buttons[i].long_press_at_us < next) {
+            next = buttons[i].long_press_at_us;
+        }
+        if (buttons[i].repeat_at_us < next) {
+            next = buttons[i].repeat_at_us;
+        }
+    }
+
+    if (next == NO_DEADLINE) {
+        return portMAX_DELAY;
+    }
+    if (next <= now) {
+        return 0;
+    }
+    // Round up so the deadline has passed when the task wakes
+    return pdMS_TO_TICKS((next - now + 999) / 1000) + 1;
+}
+
+static void button_service_task(void *params) {
+    button_edge_t edge;
+
+    while (1) {
+        TickType_t wait = ticks_until_deadline(esp_timer_get_time());
+        if (xQueueReceive(edge_queue, &edge, wait) == pdTRUE) {
+            handle_edge(&edge);
+        }
+        handle_deadlines(esp_timer_get_time());
+    }
+}
 
 void setup_buttons() {
-    gpio_pad_select_gpio(BTN_NEXT);
-    gpio_set_direction(BTN_NEXT, GPIO_MODE_INPUT);
-    gpio_set_pull_mode(BTN_NEXT, GPIO_PULLUP_ONLY);
+    edge_queue = xQueueCreate(BUTTON_EDGE_QUEUE_LEN, sizeof(button_edge_t));
+    event_queue = xQueueCreate(BUTTON_EVENT_QUEUE_LEN, sizeof(chef_button_event_t));
+    if (!edge_queue || !event_queue) {
+        ESP_LOGE(TAG, "Failed to create button queues");
+        abort();
+    }
+
+    gpio_config_t io_conf = {
+        .pin_bit_mask = 0,
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_ANYEDGE,
+    };
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        io_conf.pin_bit_mask |= 1ULL << button_pins[i];
+    }
+    ESP_ERROR_CHECK(gpio_config(&io_conf));
 
-    gpio_pad_select_gpio(BTN_PREV);
-    gpio_set_direction(BTN_PREV, GPIO_MODE_INPUT);
-    gpio_set_pull_mode(BTN_PREV, GPIO_PULLUP_ONLY);
+    // The ISR service may already be installed by another driver
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_ERR_INVALID_STATE) {
+        ESP_ERROR_CHECK(err);
+    }
 
-    gpio_pad_select_gpio(BTN_UP);
-    gpio_set_direction(BTN_UP, GPIO_MODE_INPUT);
-    gpio_set_pull_mode(BTN_UP, GPIO_PULLUP_ONLY);
+    int64_t now = esp_timer_get_time();
+    for (int i = 0; i < BUTTON_COUNT; i++) {
+        buttons[i] = (button_state_t){
+            .pressed = read_pressed(i),
+            .last_change_us = now - DEBOUNCE_US,
+            .settle_at_us = NO_DEADLINE,
+            .long_press_at_us = NO_DEADLINE,
+            .repeat_at_us = NO_DEADLINE,
+        };
+        ESP_ERROR_CHECK(gpio_isr_handler_add(button_pins[i], button_isr, (void *)(uintptr_t)i));
+    }
 
-    gpio_pad_select_gpio(BTN_DOWN);
-    gpio_set_direction(BTN_DOWN, GPIO_MODE_INPUT);
-    gpio_set_pull_mode(BTN_DOWN, GPIO_PULLUP_ONLY);
+    xTaskCreatePinnedToCore(button_service_task, "button_service", BUTTON_TASK_STACK, NULL,
+                            BUTTON_TASK_PRIORITY, NULL, BUTTON_TASK_CORE);
+}
 
-    gpio_pad_select_gpio(BTN_SELECT);
-    gpio_set_direction(BTN_SELECT, GPIO_MODE_INPUT);
-    gpio_set_pull_mode(BTN_SELECT, GPIO_PULLUP_ONLY);
+bool chef_button_receive(chef_button_event_t *event, TickType_t wait) {
+    return xQueueReceive(event_queue, event, wait) == pdTRUE;
 }
 
 void init_buzzer() {
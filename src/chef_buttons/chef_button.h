@@ -1,3 +1,9 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+
 #define BTN_NEXT 23
 #define BTN_PREV 22
 #define BTN_SELECT 14
@@ -6,7 +12,34 @@
 #define BUZZER_PIN 33
 #define FREQUENCY 4000
 
+#define BUTTON_DEBOUNCE_MS     30
+#define BUTTON_LONG_PRESS_MS   600
+#define BUTTON_REPEAT_DELAY_MS 400   // first REPEAT after the press
+#define BUTTON_REPEAT_START_MS 150   // interval to the second REPEAT
+#define BUTTON_REPEAT_MIN_MS   30    // each interval is a quarter shorter, down to this
+
+// Buttons are serviced from GPIO edge interrupts. A service task debounces the
+// edges by timestamp and publishes events to a queue; it sleeps while no button
+// is moving, so nothing polls the pins.
+
+typedef enum {
+    CHEF_BUTTON_PRESS,
+    CHEF_BUTTON_RELEASE,
+    CHEF_BUTTON_LONG_PRESS,   // still held BUTTON_LONG_PRESS_MS after the press
+    CHEF_BUTTON_REPEAT,       // sent at an accelerating rate while held
+} chef_button_event_type_t;
+
+typedef struct {
+    uint8_t pin;              // BTN_* of the button
+    uint8_t type;             // chef_button_event_type_t
+    int64_t time_us;          // esp_timer time of the edge
+} chef_button_event_t;
+
 void setup_buttons();
+
+// Wait up to `wait` ticks for the next button event. Returns false on timeout.
+bool chef_button_receive(chef_button_event_t *event, TickType_t wait);
+
 void init_buzzer();
 void turn_on_buzzer();
-void turn_off_buzzer();
\ No newline at end of file
+void turn_off_buzzer();
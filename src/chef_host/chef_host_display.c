@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "chef_host_display.h"
+
+static uint16_t framebuffer[HOST_DISPLAY_WIDTH * HOST_DISPLAY_HEIGHT];
+static uint16_t draw_buf[HOST_DISPLAY_WIDTH * HOST_DISPLAY_HEIGHT];
+static uint32_t flushes = 0;
+
+static uint32_t host_tick_cb(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
+}
+
+// Stand-in for display_flush_cb: copy the rendered area into the framebuffer
+static void host_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map) {
+    size_t width = area->x2 - area->x1 + 1;
+    const uint16_t *src = (const uint16_t *)px_map;
+
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&framebuffer[y * HOST_DISPLAY_WIDTH + area->x1], src, width * sizeof(uint16_t));
+        src += width;
+    }
+
+    flushes++;
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t* chef_host_display_init(void) {
+    lv_tick_set_cb(host_tick_cb);
+
+    lv_display_t * display = lv_display_create(HOST_DISPLAY_WIDTH, HOST_DISPLAY_HEIGHT);
+    lv_display_set_color_format(display, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_flush_cb(display, host_flush_cb);
+    chef_host_display_set_lines(display, CHEF_DRAW_BUF_LINES);
+    return display;
+}
+
+void chef_host_display_set_lines(lv_display_t * display, int lines) {
+    if (lines < 1) {
+        lines = 1;
+    } else if (lines > HOST_DISPLAY_HEIGHT) {
+        lines = HOST_DISPLAY_HEIGHT;
+    }
+    lv_display_set_buffers(display, draw_buf, NULL, HOST_DISPLAY_WIDTH * lines * sizeof(uint16_t),
+                           LV_DISPLAY_RENDER_MODE_PARTIAL);
+}
+
+uint32_t chef_host_display_flushes(void) {
+    return flushes;
+}
+
+static void rgb565_to_rgb888(uint16_t px, uint8_t *out) {
+    out[0] = ((px >> 11) & 0x1F) << 3;
+    out[1] = ((px >> 5) & 0x3F) << 2;
+    out[2] = (px & 0x1F) << 3;
+}
+
+bool chef_host_display_dump_ppm(const char* path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+
+    fprintf(f, "P6\n%d %d\n255\n", HOST_DISPLAY_WIDTH, HOST_DISPLAY_HEIGHT);
+    for (size_t i = 0; i < HOST_DISPLAY_WIDTH * HOST_DISPLAY_HEIGHT; i++) {
+        uint8_t rgb[3];
+        rgb565_to_rgb888(framebuffer[i], rgb);
+        fwrite(rgb, 1, sizeof(rgb), f);
+    }
+
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+int chef_host_display_compare_ppm(const char* path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return -1;
+    }
+
+    int width = 0, height = 0, maxval = 0;
+    if (fscanf(f, "P6 %d %d %d", &width, &height, &maxval) != 3 ||
+        width != HOST_DISPLAY_WIDTH || height != HOST_DISPLAY_HEIGHT || maxval != 255) {
+        fclose(f);
+        return -1;
+    }
+    fgetc(f);  // single whitespace after the header
+
+    int diff = 0;
+    for (size_t i = 0; i < HOST_DISPLAY_WIDTH * HOST_DISPLAY_HEIGHT; i++) {
+        uint8_t expected[3], actual[3];
+        if (fread(expected, 1, sizeof(expected), f) != sizeof(expected)) {
+            fclose(f);
+            return -1;
+        }
+        rgb565_to_rgb888(framebuffer[i], actual);
+        if (memcmp(expected, actual, sizeof(actual)) != 0) {
+            diff++;
+        }
+    }
+
+    fclose(f);
+    return diff;
+}
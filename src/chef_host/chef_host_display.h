@@ -0,0 +1,25 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include "lvgl.h"
+#include "chef_lvgl/chef_display.h"
+
+// Same geometry as the ST7735 panel
+#define HOST_DISPLAY_WIDTH  SCREEN_WIDTH
+#define HOST_DISPLAY_HEIGHT SCREEN_HEIGHT
+
+// Create an LVGL display that flushes into an in-memory RGB565 framebuffer,
+// rendering strips of CHEF_DRAW_BUF_LINES like the device
+lv_display_t* chef_host_display_init(void);
+
+// Render strips of lines rows instead, 1..HOST_DISPLAY_HEIGHT
+void chef_host_display_set_lines(lv_display_t* display, int lines);
+
+// Flushes since startup; one per strip rendered
+uint32_t chef_host_display_flushes(void);
+
+// Write the framebuffer as a binary PPM (P6); returns false on I/O error
+bool chef_host_display_dump_ppm(const char* path);
+
+// Compare the framebuffer against a PPM written by chef_host_display_dump_ppm.
+// Returns the number of differing pixels, or -1 if the file cannot be read.
+int chef_host_display_compare_ppm(const char* path);
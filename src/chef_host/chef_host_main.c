@@ -0,0 +1,265 @@
+// Headless screen benchmark: renders every screen into a memory framebuffer,
+// times the build and the per-frame refresh, and dumps or checks goldens.
+//
+//   chef_host [--out DIR] [--golden DIR] [--frames N] [--lines N,N,...]
+//
+// --lines repeats the frame timing for each draw buffer height listed, to
+// choose CHEF_DRAW_BUF_LINES. Exits non-zero if a screen fails to build or
+// differs from its golden.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lvgl.h"
+#include "esp_timer.h"
+#include "chef_host_display.h"
+#include "chef_network/chef_client.h"
+#include "chef_pack/chef_catalog.h"
+#include "chef_lvgl/chef_ui_queue.h"
+#include "chef_lvgl/chef_rgb565.h"
+#include "chef_screens/chef_styles.h"
+#include "chef_screens/chef_startup.h"
+#include "chef_screens/chef_screen_manager.h"
+
+// pio test links each test's own main against these sources
+#ifndef PIO_UNIT_TESTING
+
+#define DEFAULT_FRAMES 50
+#define MAX_LINE_COUNTS 16
+#define LINES_SLACK_PCT 5   // a strip height this close to the fastest is as good
+#define SWAP_RUNS 2000      // strips byte-swapped per kernel
+
+static const char *screen_names[CHEF_SCREEN_COUNT] = {
+    [CHEF_SCREEN_HOME]         = "home",
+    [CHEF_SCREEN_RECIPES]      = "recipes",
+    [CHEF_SCREEN_INFO]         = "info",
+    [CHEF_SCREEN_INGREDIENTS]  = "ingredients",
+    [CHEF_SCREEN_INSTRUCTIONS] = "instructions",
+    [CHEF_SCREEN_SCALE]        = "scale",
+    [CHEF_SCREEN_TIMER]        = "timer",
+};
+
+// Select the first recipe so the recipe detail screens have something to show
+static void select_first_dish(void) {
+    if (chef_catalog_count() > 0) {
+        dish = (char *)chef_catalog_name(chef_catalog_at(0));
+    }
+}
+
+// Average and worst time of a full-screen redraw of the active screen
+static int64_t time_frames(int frames, int64_t *frame_max) {
+    lv_obj_t *obj = lv_screen_active();
+    lv_refr_now(NULL);
+
+    int64_t frame_total = 0;
+    *frame_max = 0;
+    for (int f = 0; f < frames; f++) {
+        lv_obj_invalidate(obj);
+        int64_t start = esp_timer_get_time();
+        lv_refr_now(NULL);
+        int64_t elapsed = esp_timer_get_time() - start;
+        frame_total += elapsed;
+        if (elapsed > *frame_max) {
+            *frame_max = elapsed;
+        }
+    }
+    return frame_total / frames;
+}
+
+// Render every screen with each strip height. The host only measures the
+// rendering; on the device each flush also costs an SPI transaction, so fewer
+// flushes per frame is better when render times are close.
+static void sweep_lines(lv_display_t *display, const int *lines, int count, int frames) {
+    int64_t frame_avg[MAX_LINE_COUNTS];
+    int64_t best = INT64_MAX;
+
+    printf("\n%-6s %10s %10s %10s\n", "lines", "dma_bytes", "flushes", "frame_avg");
+    for (int i = 0; i < count; i++) {
+        chef_host_display_set_lines(display, lines[i]);
+        int64_t total = 0;
+        uint32_t flushes = 0;
+        for (int id = 0; id < CHEF_SCREEN_COUNT; id++) {
+            if (!chef_screen_show(id)) {
+                continue;
+            }
+            chef_ui_queue_drain();
+            lv_refr_now(NULL);  // the screen switch, not counted
+            int64_t frame_max;
+            uint32_t before = chef_host_display_flushes();
+            total += time_frames(frames, &frame_max);
+            flushes += chef_host_display_flushes() - before;
+        }
+        frame_avg[i] = total / CHEF_SCREEN_COUNT;
+        if (frame_avg[i] < best) {
+            best = frame_avg[i];
+        }
+        // two strips, as lvgl_setup allocates them
+        printf("%-6d %10d %10.1f %10lld\n", lines[i], 2 * HOST_DISPLAY_WIDTH * lines[i] * (int)sizeof(uint16_t),
+               (double)flushes / (frames * CHEF_SCREEN_COUNT), (long long)frame_avg[i]);
+    }
+
+    // lines are listed in increasing order, so the first one close enough uses the least memory
+    for (int i = 0; i < count; i++) {
+        if (frame_avg[i] * 100 <= best * (100 + LINES_SLACK_PCT)) {
+            printf("suggested CHEF_DRAW_BUF_LINES %d: least memory within %d%% of the fastest\n",
+                   lines[i], LINES_SLACK_PCT);
+            break;
+        }
+    }
+    chef_host_display_set_lines(display, CHEF_DRAW_BUF_LINES);
+}
+
+// Per-pixel cost of the byte swap display_flush_cb does on every strip, ours
+// against LVGL's. An odd pixel count covers the tail; the results must match.
+static bool time_rgb565_swap(void) {
+    enum { PX = HOST_DISPLAY_WIDTH * CHEF_DRAW_BUF_LINES - 1 };
+    static uint32_t ours[(PX + 1) / 2], lvgl[(PX + 1) / 2];
+    for (size_t i = 0; i < PX; i++) {
+        ((uint16_t *)ours)[i] = ((uint16_t *)lvgl)[i] = (uint16_t)(i * 2654435761u >> 16);
+    }
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < SWAP_RUNS; i++) {
+        chef_rgb565_swap((uint8_t *)ours, PX);
+    }
+    int64_t ours_us = esp_timer_get_time() - start;
+
+    start = esp_timer_get_time();
+    for (int i = 0; i < SWAP_RUNS; i++) {
+        lv_draw_sw_rgb565_swap(lvgl, PX);
+    }
+    int64_t lvgl_us = esp_timer_get_time() - start;
+
+    printf("\nrgb565 swap, %d px strips: chef_rgb565_swap %.3f ns/px, lv_draw_sw_rgb565_swap %.3f ns/px\n",
+           PX, ours_us * 1000.0 / ((double)SWAP_RUNS * PX), lvgl_us * 1000.0 / ((double)SWAP_RUNS * PX));
+    // an even number of runs leaves both buffers as they started
+    if (memcmp(ours, lvgl, PX * sizeof(uint16_t)) != 0) {
+        fprintf(stderr, "rgb565 swap: chef_rgb565_swap and lv_draw_sw_rgb565_swap disagree\n");
+        return false;
+    }
+    return true;
+}
+
+// "10,20,40" into lines, in increasing order; returns the count, 0 if malformed
+static int parse_lines(const char *list, int *lines) {
+    for (int count = 0; count < MAX_LINE_COUNTS; ) {
+        char *end;
+        long n = strtol(list, &end, 10);
+        if (end == list || n < 1 || n > HOST_DISPLAY_HEIGHT || (count > 0 && n <= lines[count - 1])) {
+            return 0;
+        }
+        lines[count++] = n;
+        if (*end == '\0') {
+            return count;
+        }
+        if (*end != ',') {
+            return 0;
+        }
+        list = end + 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    const char *out_dir = NULL;
+    const char *golden_dir = NULL;
+    int frames = DEFAULT_FRAMES;
+    int lines[MAX_LINE_COUNTS];
+    int line_count = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            golden_dir = argv[++i];
+        } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            frames = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--lines") == 0 && i + 1 < argc &&
+                   (line_count = parse_lines(argv[++i], lines)) > 0) {
+            continue;
+        } else {
+            fprintf(stderr, "usage: %s [--out DIR] [--golden DIR] [--frames N] [--lines N,N,...]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (frames < 1) {
+        frames = 1;
+    }
+
+    fetch_github_json();
+    chef_catalog_load(fetch_recipe_pack());
+    select_first_dish();
+
+    lv_init();
+    lv_display_t *display = chef_host_display_init();
+    chef_ui_queue_init();
+    chef_init_styles();
+
+    int failures = 0;
+    char path[512];
+
+    printf("%d line draw buffer\n", CHEF_DRAW_BUF_LINES);
+    printf("%-12s %10s %10s %10s %10s %10s\n", "screen", "build_us", "show_us",
+           "frame_avg", "frame_max", "idle_us");
+
+    for (int id = 0; id < CHEF_SCREEN_COUNT; id++) {
+        const char *name = screen_names[id];
+
+        // First visit builds the screen
+        int64_t start = esp_timer_get_time();
+        bool shown = chef_screen_show(id);
+        chef_ui_queue_drain();
+        int64_t build_us = esp_timer_get_time() - start;
+        if (!shown) {
+            fprintf(stderr, "%s: screen was not created\n", name);
+            failures++;
+            continue;
+        }
+
+        // Leave and come back to time a cached navigation
+        chef_screen_show(id == CHEF_SCREEN_HOME ? CHEF_SCREEN_RECIPES : CHEF_SCREEN_HOME);
+        chef_ui_queue_drain();
+        start = esp_timer_get_time();
+        chef_screen_show(id);
+        chef_ui_queue_drain();
+        int64_t show_us = esp_timer_get_time() - start;
+
+        // Full-screen redraws
+        int64_t frame_max;
+        int64_t frame_avg = time_frames(frames, &frame_max);
+
+        // Timer handler pass with nothing invalidated
+        start = esp_timer_get_time();
+        lv_timer_handler();
+        int64_t idle_us = esp_timer_get_time() - start;
+
+        printf("%-12s %10lld %10lld %10lld %10lld %10lld\n", name, (long long)build_us, (long long)show_us,
+               (long long)frame_avg, (long long)frame_max, (long long)idle_us);
+
+        if (out_dir) {
+            snprintf(path, sizeof(path), "%s/%s.ppm", out_dir, name);
+            if (!chef_host_display_dump_ppm(path)) {
+                fprintf(stderr, "%s: cannot write %s\n", name, path);
+                failures++;
+            }
+        }
+
+        if (golden_dir) {
+            snprintf(path, sizeof(path), "%s/%s.ppm", golden_dir, name);
+            int diff = chef_host_display_compare_ppm(path);
+            if (diff != 0) {
+                fprintf(stderr, "%s: %d pixels differ from %s\n", name, diff, path);
+                failures++;
+            }
+        }
+    }
+
+    if (!time_rgb565_swap()) {
+        failures++;
+    }
+    if (line_count) {
+        sweep_lines(display, lines, line_count, frames);
+    }
+
+    return failures ? 1 : 0;
+}
+#endif
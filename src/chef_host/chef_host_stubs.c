@@ -0,0 +1,157 @@
+// Host implementations of the FreeRTOS and driver calls made by the screens.
+// Tasks are never started: the host renders screens, it does not run them.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "chef_buttons/chef_button.h"
+#include "chef_scale/chef_scale_service.h"
+#include "chef_lvgl/chef_render.h"
+#include "chef_network/chef_client.h"
+#include "chef_network/chef_recipe_stream.h"
+#include "chef_tools/chef_recipe_check.h"
+#include "chef_tools/chef_pack_writer.h"
+
+#define DEFAULT_RECIPES_PATH "recipes.json"
+
+static uint8_t *pack_image;
+static const chef_pack_t *recipes_pack;
+
+int64_t esp_timer_get_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char *name, uint32_t stack_depth,
+                                   void *params, UBaseType_t priority,
+                                   TaskHandle_t *handle, BaseType_t core_id) {
+    if (handle) {
+        *handle = NULL;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char *name, uint32_t stack_depth,
+                       void *params, UBaseType_t priority, TaskHandle_t *handle) {
+    return xTaskCreatePinnedToCore(fn, name, stack_depth, params, priority, handle, 0);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+}
+
+void vTaskDelay(TickType_t ticks) {
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    return NULL;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t wait) {
+    return pdFAIL;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t wait) {
+    return pdFALSE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    return 0;
+}
+
+// chef_lvgl: the host renders explicitly with lv_refr_now
+void chef_render_request(void) {}
+
+// chef_buttons
+void setup_buttons() {}
+bool chef_button_receive(chef_button_event_t *event, TickType_t wait) { return false; }
+void init_buzzer() {}
+void turn_on_buzzer() {}
+void turn_off_buzzer() {}
+
+// chef_scale: the service never starts on the host
+chef_scale_sub_t chef_scale_subscribe(chef_scale_cb_t cb, void *ctx) { return CHEF_SCALE_NO_SUB; }
+void chef_scale_unsubscribe(chef_scale_sub_t sub) {}
+
+// chef_network: compile the catalog from disk into a pack in memory, checked
+// and normalized as chef_packc does, instead of downloading a pack.
+// CHEF_RECIPES overrides the default path.
+#define HOST_CHUNK 536  // a typical TCP segment
+
+static bool image_write(void *ctx, uint32_t offset, const void *data, size_t len) {
+    memcpy((uint8_t *)ctx + offset, data, len);
+    return true;
+}
+
+static bool image_read(void *ctx, uint32_t offset, void *data, size_t len) {
+    memcpy(data, (uint8_t *)ctx + offset, len);
+    return true;
+}
+
+typedef struct {
+    chef_pack_writer_t pack;
+    chef_recipe_report_t report;
+    int count;
+} host_load_t;
+
+// Recipes that fail the schema are left out, as they would be rejected by chef_packc
+static bool add_recipe(cJSON *recipe, void *ctx) {
+    host_load_t *load = ctx;
+    if (chef_recipe_check(recipe, load->count++, &load->report)) {
+        chef_pack_writer_add(&load->pack, recipe);
+    }
+    cJSON_Delete(recipe);
+    return !load->pack.failed;
+}
+
+void fetch_github_json() {
+    const char *path = getenv("CHEF_RECIPES");
+    if (!path) {
+        path = DEFAULT_RECIPES_PATH;
+    }
+
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return;
+    }
+
+    // erased flash reads as 0xFF
+    uint8_t *image = malloc(CHEF_PACK_MAX_SIZE);
+    memset(image, 0xFF, CHEF_PACK_MAX_SIZE);
+    chef_pack_io_t io = { .write = image_write, .read = image_read, .ctx = image };
+    host_load_t *load = calloc(1, sizeof(*load));
+    load->report.log = stderr;
+    chef_pack_writer_init(&load->pack, &io, CHEF_PACK_MAX_SIZE, CHEF_PACK_MAX_RECIPES);
+    chef_recipe_stream_t *stream = malloc(sizeof(*stream));
+    chef_recipe_stream_init(stream, add_recipe, load);
+
+    char chunk[HOST_CHUNK];
+    size_t n;
+    bool ok = true;
+    while (ok && (n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        ok = chef_recipe_stream_feed(stream, chunk, n);
+    }
+    ok = ok && chef_recipe_stream_finish(stream);
+    ok = ok && chef_pack_writer_finish(&load->pack, 1);
+    free(stream);
+    free(load);
+    fclose(f);
+
+    if (ok) {
+        free(pack_image);
+        pack_image = image;
+        recipes_pack = chef_pack_open(image, CHEF_PACK_MAX_SIZE);
+    } else {
+        fprintf(stderr, "Cannot parse %s\n", path);
+        free(image);
+    }
+}
+
+const chef_pack_t* fetch_recipe_pack() {
+    return recipes_pack;
+}
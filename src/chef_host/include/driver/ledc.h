@@ -0,0 +1,4 @@
+// Host stand-in for ESP-IDF driver/ledc.h
+#pragma once
+
+#include "driver/gpio.h"
@@ -0,0 +1,11 @@
+// Host stand-in for FreeRTOS event_groups.h
+#pragma once
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+typedef void *EventGroupHandle_t;
+typedef uint32_t EventBits_t;
+
+#define BIT0 (1u << 0)
+#define BIT1 (1u << 1)
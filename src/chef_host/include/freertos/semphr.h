@@ -0,0 +1,6 @@
+// Host stand-in for FreeRTOS semphr.h
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void *SemaphoreHandle_t;
@@ -0,0 +1,2 @@
+// Host stand-in for ESP-IDF rom/gpio.h
+#pragma once
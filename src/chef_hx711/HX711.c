@@ -1,177 +1,726 @@
 #include "HX711.h"
 #include "esp_log.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "esp_rom_gpio.h"
+#include "driver/spi_master.h"
+#include "soc/spi_periph.h"
+#include <stdatomic.h>
+#include <inttypes.h>
 #include <rom/ets_sys.h>
 
 #define HIGH 1
 #define LOW 0
-#define CLOCK_DELAY_US 20
+#define CLOCK_DELAY_US 1	// PD_SCK half period; the datasheet allows 0.2 to 50 us high
+
+#define ACQ_TASK_STACK 2048
+#define ACQ_TASK_PRIORITY 6
+#define ACQ_TASK_CORE 0
+#define ACQ_READY_TIMEOUT_MS 200	// re-check DOUT if a ready edge was missed (10 SPS is 100 ms)
+
+#define HX711_SPI_HOST SPI3_HOST	// the display owns SPI2
+#define SPI_CLOCK_HZ 1000000	// one SPI bit per PD_SCK half period: 1 us high, 1 us low
+#define SPI_FRAME_BYTES 7		// 27 pulses at most, two bits each
+
+#define DEFAULT_SCALE 50	// counts per unit; used to return weight in grams, kg, ounces, whatever
 
 #define DEBUGTAG "HX711"
 
-static gpio_num_t GPIO_PD_SCK = GPIO_NUM_12;	// Power Down and Serial Clock Input Pin
-static gpio_num_t GPIO_DOUT = GPIO_NUM_27;		// Serial Data Output Pin
-static HX711_GAIN GAIN = eGAIN_128;		// amplification factor
-static unsigned long OFFSET = 0;	// used for tare weight
-static float SCALE = 50;	// used to return weight in grams, kg, ounces, whatever
+// Clock-out must not be interrupted for long: PD_SCK high for more than 60 us powers the chip down
+static portMUX_TYPE hx711_mux = portMUX_INITIALIZER_UNLOCKED;
 
-void HX711_init(gpio_num_t dout, gpio_num_t pd_sck, HX711_GAIN gain )
+// Sample ring. Slot n % HX711_RING_SIZE holds sample n. Its seq is 2n+1 while the writer fills
+// it and 2n+2 once complete, so a reader can tell a torn or overwritten copy from a good one.
+typedef struct
+{
+	atomic_uint seq;
+	HX711_sample_t sample;
+} HX711_slot_t;
+
+struct HX711_dev
+{
+	gpio_num_t pd_sck;						// Power Down and Serial Clock Input Pin, shared
+	gpio_num_t dout[HX711_MAX_CHANNELS];	// Serial Data Output Pins
+	uint8_t channels;
+	HX711_GAIN gain;						// amplification factor
+	int32_t offset[HX711_MAX_CHANNELS];		// used for tare weight
+	int32_t gain_q[HX711_MAX_CHANNELS];		// milli-units per count, Q HX711_GAIN_Q
+
+	// SPI backend. Each PD_SCK pulse is the bit pair 1,0 on MOSI and DOUT is sampled on MISO in
+	// the middle of the high bit, so the chip sees a hardware-timed clock and no critical section
+	// is needed
+	HX711_BACKEND backend;
+	spi_device_handle_t spi_dev;
+	uint8_t spi_tx[SPI_FRAME_BYTES];
+
+	// Background acquisition
+	TaskHandle_t acq_task;
+	volatile bool acq_running;
+	volatile int64_t ready_time_us;
+
+	HX711_slot_t ring[HX711_RING_SIZE];
+	atomic_uint ring_head;	// number of samples written
+	TaskHandle_t volatile reader;	// notified after each push
+};
+
+static HX711_dev_t *default_dev = NULL;
+static bool spi_host_taken = false;	// one SPI backend instance at a time
+
+static bool HX711_spi_setup(HX711_dev_t *dev)
+{
+	if (spi_host_taken)
+	{
+		ESP_LOGE(DEBUGTAG, "SPI host already in use by another HX711");
+		return false;
+	}
+
+	spi_bus_config_t buscfg = {
+		.mosi_io_num = dev->pd_sck,
+		.miso_io_num = dev->dout[0],
+		.sclk_io_num = -1,
+		.quadwp_io_num = -1,
+		.quadhd_io_num = -1,
+		.max_transfer_sz = SPI_FRAME_BYTES,
+	};
+	esp_err_t err = spi_bus_initialize(HX711_SPI_HOST, &buscfg, SPI_DMA_DISABLED);
+	if (err != ESP_OK)
+	{
+		ESP_LOGE(DEBUGTAG, "SPI bus init failed: %d", err);
+		return false;
+	}
+
+	spi_device_interface_config_t devcfg = {
+		.clock_speed_hz = SPI_CLOCK_HZ,
+		.mode = 0,
+		.spics_io_num = -1,
+		.queue_size = 1,
+	};
+	err = spi_bus_add_device(HX711_SPI_HOST, &devcfg, &dev->spi_dev);
+	if (err != ESP_OK)
+	{
+		ESP_LOGE(DEBUGTAG, "SPI device add failed: %d", err);
+		spi_bus_free(HX711_SPI_HOST);
+		dev->spi_dev = NULL;
+		return false;
+	}
+	spi_host_taken = true;
+	return true;
+}
+
+static void HX711_spi_release(HX711_dev_t *dev)
+{
+	if (dev->spi_dev)
+	{
+		spi_bus_remove_device(dev->spi_dev);
+		spi_bus_free(HX711_SPI_HOST);
+		dev->spi_dev = NULL;
+		spi_host_taken = false;
+	}
+}
+
+// one 1,0 bit pair per pulse, zeros after, so MOSI (PD_SCK) idles low between frames
+static void HX711_spi_build_tx(HX711_dev_t *dev)
+{
+	memset(dev->spi_tx, 0, sizeof(dev->spi_tx));
+	for (int i = 0; i < 24 + dev->gain; i++)
+	{
+		int bit = 2 * i;
+		dev->spi_tx[bit / 8] |= 0x80 >> (bit % 8);
+	}
+}
+
+HX711_dev_t *HX711_open(const HX711_config_t *config)
 {
-	GPIO_PD_SCK = pd_sck;
-	GPIO_DOUT = dout;
+	if (config->channels < 1 || config->channels > HX711_MAX_CHANNELS)
+	{
+		ESP_LOGE(DEBUGTAG, "Unsupported channel count %d", config->channels);
+		return NULL;
+	}
+
+	HX711_dev_t *dev = calloc(1, sizeof(HX711_dev_t));
+	if (!dev)
+	{
+		return NULL;
+	}
+	dev->pd_sck = config->pd_sck;
+	dev->channels = config->channels;
+	for (int c = 0; c < dev->channels; c++)
+	{
+		dev->dout[c] = config->dout[c];
+		dev->gain_q[c] = HX711_scale_to_gain(DEFAULT_SCALE);
+	}
 
 	gpio_config_t io_conf;
     io_conf.intr_type = GPIO_INTR_DISABLE;
     io_conf.mode = GPIO_MODE_OUTPUT;
-    io_conf.pin_bit_mask = (1ULL<<GPIO_PD_SCK);
+    io_conf.pin_bit_mask = (1ULL<<dev->pd_sck);
     io_conf.pull_down_en = 0;
     io_conf.pull_up_en = 0;
     gpio_config(&io_conf);
 
     io_conf.intr_type = GPIO_INTR_DISABLE;
-    io_conf.pin_bit_mask = (1ULL<<GPIO_DOUT);
+    io_conf.pin_bit_mask = 0;
+	for (int c = 0; c < dev->channels; c++)
+	{
+		io_conf.pin_bit_mask |= 1ULL<<dev->dout[c];
+	}
     io_conf.mode = GPIO_MODE_INPUT;
     io_conf.pull_up_en = 0;
 	gpio_config(&io_conf);
 
-	HX711_set_gain(gain);
+	dev->backend = eBACKEND_GPIO;
+	if (config->backend == eBACKEND_SPI)
+	{
+		// MISO is a single line, so several chips are always bit-banged
+		if (dev->channels == 1 && HX711_spi_setup(dev))
+		{
+			dev->backend = eBACKEND_SPI;
+		}
+		else
+		{
+			ESP_LOGW(DEBUGTAG, "Falling back to GPIO clocking");
+		}
+	}
+
+	dev->gain = config->gain;
+	HX711_spi_build_tx(dev);
+	// one read selects the gain for the following conversion
+	HX711_sample_t sample;
+	HX711_dev_read(dev, &sample);
+	return dev;
+}
+
+void HX711_close(HX711_dev_t *dev)
+{
+	if (!dev)
+	{
+		return;
+	}
+	HX711_dev_stop_acquisition(dev);
+	while (dev->acq_task)
+	{
+		vTaskDelay(10 / portTICK_PERIOD_MS);
+	}
+	HX711_spi_release(dev);
+	if (dev == default_dev)
+	{
+		default_dev = NULL;
+	}
+	free(dev);
+}
+
+HX711_dev_t *HX711_default()
+{
+	return default_dev;
+}
+
+uint8_t HX711_dev_channels(HX711_dev_t *dev)
+{
+	return dev->channels;
+}
+
+void HX711_init(gpio_num_t dout, gpio_num_t pd_sck, HX711_GAIN gain )
+{
+	HX711_init_backend(dout, pd_sck, gain, eBACKEND_GPIO);
+}
+
+void HX711_init_backend(gpio_num_t dout, gpio_num_t pd_sck, HX711_GAIN gain, HX711_BACKEND backend)
+{
+	HX711_config_t config = {
+		.pd_sck = pd_sck,
+		.dout = { dout },
+		.channels = 1,
+		.gain = gain,
+		.backend = backend,
+	};
+	HX711_close(default_dev);
+	default_dev = HX711_open(&config);
+}
+
+// every chip has a conversion waiting
+static bool HX711_all_ready(HX711_dev_t *dev)
+{
+	for (int c = 0; c < dev->channels; c++)
+	{
+		if (gpio_get_level(dev->dout[c]))
+		{
+			return false;
+		}
+	}
+	return true;
 }
 
 bool HX711_is_ready()
 {
-	return gpio_get_level(GPIO_DOUT);
+	return gpio_get_level(default_dev->dout[0]);
 }
 
 void HX711_set_gain(HX711_GAIN gain)
 {
-	GAIN = gain;
-	gpio_set_level(GPIO_PD_SCK, LOW);
+	HX711_dev_t *dev = default_dev;
+	// the acquisition task clocks frames out of spi_tx and by dev->gain: change them between
+	// its runs, not under a transaction
+	bool running = dev->acq_running;
+	HX711_dev_stop_acquisition(dev);
+	while (dev->acq_task)
+	{
+		vTaskDelay(10 / portTICK_PERIOD_MS);
+	}
+
+	dev->gain = gain;
+	HX711_spi_build_tx(dev);
+	// the new gain is selected by the pulses after the next frame
 	HX711_read();
+
+	if (running)
+	{
+		HX711_dev_start_acquisition(dev);
+	}
 }
 
-uint8_t HX711_shiftIn()
+static void HX711_read_frame_spi(HX711_dev_t *dev, int32_t *raw)
 {
-	uint8_t value = 0;
-
-    for(int i = 0; i < 8; ++i) 
-    {
-        gpio_set_level(GPIO_PD_SCK, HIGH);
-        ets_delay_us(CLOCK_DELAY_US);
-        value |= gpio_get_level(GPIO_DOUT) << (7 - i); //get level returns 
-        gpio_set_level(GPIO_PD_SCK, LOW);
-        ets_delay_us(CLOCK_DELAY_US);
-    }
+	uint8_t rx[SPI_FRAME_BYTES];
+	spi_transaction_t t = {
+		.length = SPI_FRAME_BYTES * 8,
+		.tx_buffer = dev->spi_tx,
+		.rx_buffer = rx,
+	};
+	// about 60 us of busy-wait with interrupts enabled; a preemption only stretches the low time
+	spi_device_polling_transmit(dev->spi_dev, &t);
+
+	int32_t value = 0;
+	for (int i = 0; i < 24; i++)
+	{
+		int bit = 2 * i;
+		value = (value << 1) | ((rx[bit / 8] >> (7 - bit % 8)) & 1);
+	}
 
-    return value;
+	raw[0] = HX711_SIGN_EXTEND(value);
 }
 
-unsigned long HX711_read()
+// clock out one conversion from every chip (all DOUT must already be low) and select the gain
+// for the next one. The chips share PD_SCK, so each pulse shifts one bit out of all of them
+static void HX711_read_frame(HX711_dev_t *dev, int32_t *raw)
 {
-	gpio_set_level(GPIO_PD_SCK, LOW);
-	// wait for the chip to become ready
-	while (HX711_is_ready()) 
+	if (dev->backend == eBACKEND_SPI)
 	{
-		vTaskDelay(10 / portTICK_PERIOD_MS);
+		HX711_read_frame_spi(dev, raw);
+		return;
 	}
 
-	unsigned long value = 0;
+	for (int c = 0; c < dev->channels; c++)
+	{
+		raw[c] = 0;
+	}
 
 	//--- Enter critical section ----
-	portDISABLE_INTERRUPTS();
+	portENTER_CRITICAL(&hx711_mux);
 
 	for(int i=0; i < 24 ; i++)
 	{   
-		gpio_set_level(GPIO_PD_SCK, HIGH);
+		gpio_set_level(dev->pd_sck, HIGH);
         ets_delay_us(CLOCK_DELAY_US);
-        value = value << 1;
-        gpio_set_level(GPIO_PD_SCK, LOW);
+        gpio_set_level(dev->pd_sck, LOW);
         ets_delay_us(CLOCK_DELAY_US);
 
-        if(gpio_get_level(GPIO_DOUT))
-        	value++;
+		for (int c = 0; c < dev->channels; c++)
+		{
+			raw[c] = (raw[c] << 1) | gpio_get_level(dev->dout[c]);
+		}
 	}
 
 	// set the channel and the gain factor for the next reading using the clock pin
-	for (unsigned int i = 0; i < GAIN; i++) 
+	for (unsigned int i = 0; i < dev->gain; i++) 
 	{	
-		gpio_set_level(GPIO_PD_SCK, HIGH);
+		gpio_set_level(dev->pd_sck, HIGH);
 		ets_delay_us(CLOCK_DELAY_US);
-		gpio_set_level(GPIO_PD_SCK, LOW);
+		gpio_set_level(dev->pd_sck, LOW);
 		ets_delay_us(CLOCK_DELAY_US);
 	}	
-	portENABLE_INTERRUPTS();
+	portEXIT_CRITICAL(&hx711_mux);
 	//--- Exit critical section ----
 
-	value =value^0x800000;
+	for (int c = 0; c < dev->channels; c++)
+	{
+		raw[c] = HX711_SIGN_EXTEND(raw[c]);
+	}
+}
+
+int32_t HX711_scale_to_gain(float scale)
+{
+	return (int32_t)(1000.0f * (1 << HX711_GAIN_Q) / scale + 0.5f);
+}
+
+float HX711_gain_to_scale(int32_t gain_q)
+{
+	return 1000.0f * (1 << HX711_GAIN_Q) / gain_q;
+}
 
-	return (value);
+// calibrated channels summed, in milli-units. Integer only: this runs for every conversion.
+// A 25-bit difference times a gain of up to 31 bits needs the 64-bit product; the shares
+// are summed in 64 bits too and clamped to int32 once, at the end
+static int32_t HX711_weight_mg(HX711_dev_t *dev, const int32_t *raw)
+{
+	int64_t weight = 0;
+	for (int c = 0; c < dev->channels; c++)
+	{
+		int64_t q = ((int64_t)raw[c] - dev->offset[c]) * dev->gain_q[c];
+		weight += (q + (1 << (HX711_GAIN_Q - 1))) >> HX711_GAIN_Q;
+	}
+	if (weight > INT32_MAX)
+		return INT32_MAX;
+	if (weight < INT32_MIN)
+		return INT32_MIN;
+	return (int32_t)weight;
 }
 
+void HX711_dev_read(HX711_dev_t *dev, HX711_sample_t *sample)
+{
+	// the acquisition task owns the clock line while it runs
+	if (dev->acq_running)
+	{
+		uint32_t cursor = HX711_dev_sample_cursor(dev);
+		while (!HX711_dev_next_sample(dev, &cursor, sample))
+		{
+			vTaskDelay(10 / portTICK_PERIOD_MS);
+		}
+		return;
+	}
 
+	gpio_set_level(dev->pd_sck, LOW);
+	// wait for every chip to become ready
+	while (!HX711_all_ready(dev)) 
+	{
+		vTaskDelay(10 / portTICK_PERIOD_MS);
+	}
 
-unsigned long  HX711_read_average(char times) 
+	sample->time_us = esp_timer_get_time();
+	HX711_read_frame(dev, sample->raw);
+	sample->weight_mg = HX711_weight_mg(dev, sample->raw);
+}
+
+int32_t HX711_read()
+{
+	HX711_sample_t sample;
+	HX711_dev_read(default_dev, &sample);
+	return sample.raw[0];
+}
+
+static void HX711_ring_push(HX711_dev_t *dev, const int32_t *raw, int64_t time_us)
+{
+	unsigned int n = atomic_load_explicit(&dev->ring_head, memory_order_relaxed);
+	HX711_slot_t *slot = &dev->ring[n & (HX711_RING_SIZE - 1)];
+
+	atomic_store_explicit(&slot->seq, 2 * n + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	slot->sample.time_us = time_us;
+	memcpy(slot->sample.raw, raw, sizeof(slot->sample.raw));
+	slot->sample.weight_mg = HX711_weight_mg(dev, raw);
+	atomic_store_explicit(&slot->seq, 2 * n + 2, memory_order_release);
+	atomic_store_explicit(&dev->ring_head, n + 1, memory_order_release);
+}
+
+uint32_t HX711_dev_sample_cursor(HX711_dev_t *dev)
+{
+	return atomic_load_explicit(&dev->ring_head, memory_order_acquire);
+}
+
+bool HX711_dev_next_sample(HX711_dev_t *dev, uint32_t *cursor, HX711_sample_t *sample)
+{
+	while (1)
+	{
+		unsigned int head = atomic_load_explicit(&dev->ring_head, memory_order_acquire);
+		if (*cursor == head)
+		{
+			return false;
+		}
+		if (head - *cursor > HX711_RING_SIZE)
+		{
+			*cursor = head - HX711_RING_SIZE;	// overrun: skip to the oldest stored sample
+		}
+
+		HX711_slot_t *slot = &dev->ring[*cursor & (HX711_RING_SIZE - 1)];
+		unsigned int seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+		HX711_sample_t copy = slot->sample;
+		atomic_thread_fence(memory_order_acquire);
+		if (seq == 2 * *cursor + 2 && atomic_load_explicit(&slot->seq, memory_order_relaxed) == seq)
+		{
+			*sample = copy;
+			(*cursor)++;
+			return true;
+		}
+		// the writer lapped this slot while it was copied; retry from the new head
+	}
+}
+
+void HX711_dev_set_reader(HX711_dev_t *dev, TaskHandle_t reader)
+{
+	dev->reader = reader;
+}
+
+void HX711_set_reader(TaskHandle_t reader)
+{
+	HX711_dev_set_reader(default_dev, reader);
+}
+
+uint32_t HX711_sample_cursor()
+{
+	return HX711_dev_sample_cursor(default_dev);
+}
+
+bool HX711_next_sample(uint32_t *cursor, HX711_sample_t *sample)
+{
+	return HX711_dev_next_sample(default_dev, cursor, sample);
+}
+
+static void HX711_arm(HX711_dev_t *dev, bool enable)
+{
+	for (int c = 0; c < dev->channels; c++)
+	{
+		if (enable)
+			gpio_intr_enable(dev->dout[c]);
+		else
+			gpio_intr_disable(dev->dout[c]);
+	}
+}
+
+// A DOUT fell: that chip has a conversion ready. DOUT toggles while the frame is clocked out,
+// so the interrupts stay off until the acquisition task re-arms them. The last edge before all
+// chips are ready gives the sample time.
+static void IRAM_ATTR HX711_dout_isr(void *arg)
+{
+	HX711_dev_t *dev = arg;
+	BaseType_t woken = pdFALSE;
+	dev->ready_time_us = esp_timer_get_time();
+	for (int c = 0; c < dev->channels; c++)
+	{
+		gpio_intr_disable(dev->dout[c]);
+	}
+	vTaskNotifyGiveFromISR(dev->acq_task, &woken);
+	if (woken)
+	{
+		portYIELD_FROM_ISR();
+	}
+}
+
+static void HX711_acquisition_task(void *arg)
+{
+	HX711_dev_t *dev = arg;
+	int32_t raw[HX711_MAX_CHANNELS] = { 0 };
+
+	while (dev->acq_running)
+	{
+		HX711_arm(dev, true);
+		// a conversion that completed before the interrupts were armed has no edge left to catch
+		if (!HX711_all_ready(dev) &&
+			ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ACQ_READY_TIMEOUT_MS)) == 0)
+		{
+			continue;
+		}
+		HX711_arm(dev, false);
+		// one chip being ready is not enough; wait for the next edge from the others
+		if (!dev->acq_running || !HX711_all_ready(dev))
+		{
+			continue;
+		}
+
+		int64_t time_us = dev->ready_time_us;
+		if (time_us == 0)
+		{
+			time_us = esp_timer_get_time();
+		}
+		dev->ready_time_us = 0;
+		HX711_read_frame(dev, raw);
+		HX711_ring_push(dev, raw, time_us);
+		TaskHandle_t reader = dev->reader;
+		if (reader)
+		{
+			xTaskNotifyGive(reader);
+		}
+	}
+
+	HX711_arm(dev, false);
+	dev->acq_task = NULL;
+	vTaskDelete(NULL);
+}
+
+void HX711_dev_start_acquisition(HX711_dev_t *dev)
+{
+	if (dev->acq_running)
+	{
+		return;
+	}
+	// a task from a previous stop may still be winding down
+	while (dev->acq_task)
+	{
+		vTaskDelay(10 / portTICK_PERIOD_MS);
+	}
+	ESP_LOGI(DEBUGTAG, "Starting interrupt-driven acquisition");
+
+	// the ISR service may already be installed by another driver
+	esp_err_t err = gpio_install_isr_service(0);
+	if (err != ESP_OK && err != ESP_ERR_INVALID_STATE)
+	{
+		ESP_LOGE(DEBUGTAG, "Failed to install GPIO ISR service: %d", err);
+		return;
+	}
+
+	gpio_set_level(dev->pd_sck, LOW);
+	for (int c = 0; c < dev->channels; c++)
+	{
+		gpio_set_intr_type(dev->dout[c], GPIO_INTR_NEGEDGE);
+	}
+	HX711_arm(dev, false);
+
+	dev->acq_running = true;
+	xTaskCreatePinnedToCore(HX711_acquisition_task, "hx711_acq", ACQ_TASK_STACK, dev,
+							ACQ_TASK_PRIORITY, &dev->acq_task, ACQ_TASK_CORE);
+	for (int c = 0; c < dev->channels; c++)
+	{
+		gpio_isr_handler_add(dev->dout[c], HX711_dout_isr, dev);
+	}
+}
+
+void HX711_dev_stop_acquisition(HX711_dev_t *dev)
+{
+	if (!dev->acq_running)
+	{
+		return;
+	}
+	ESP_LOGI(DEBUGTAG, "Stopping acquisition");
+	for (int c = 0; c < dev->channels; c++)
+	{
+		gpio_isr_handler_remove(dev->dout[c]);
+	}
+	// the task exits on its own within ACQ_READY_TIMEOUT_MS, after any frame in progress
+	dev->acq_running = false;
+}
+
+void HX711_start_acquisition()
+{
+	HX711_dev_start_acquisition(default_dev);
+}
+
+void HX711_stop_acquisition()
+{
+	HX711_dev_stop_acquisition(default_dev);
+}
+
+void HX711_dev_tare(HX711_dev_t *dev, uint8_t times)
+{
+	int64_t sum[HX711_MAX_CHANNELS] = { 0 };
+	HX711_sample_t sample;
+	for (uint8_t i = 0; i < times; i++)
+	{
+		HX711_dev_read(dev, &sample);
+		for (int c = 0; c < dev->channels; c++)
+		{
+			sum[c] += sample.raw[c];
+		}
+	}
+	for (int c = 0; c < dev->channels; c++)
+	{
+		dev->offset[c] = sum[c] / times;
+	}
+}
+
+void HX711_dev_set_calibration(HX711_dev_t *dev, uint8_t channel, int32_t offset, int32_t gain_q)
+{
+	dev->offset[channel] = offset;
+	dev->gain_q[channel] = gain_q;
+}
+
+void HX711_dev_get_calibration(HX711_dev_t *dev, uint8_t channel, int32_t *offset, int32_t *gain_q)
+{
+	*offset = dev->offset[channel];
+	*gain_q = dev->gain_q[channel];
+}
+
+int32_t HX711_read_average(char times) 
 {
 	ESP_LOGI(DEBUGTAG, "===================== READ AVERAGE START ====================");
-	unsigned long sum = 0;
+	int64_t sum = 0;
 	for (char i = 0; i < times; i++) 
 	{
 		sum += HX711_read();
 	}
-	ESP_LOGI(DEBUGTAG, "===================== READ AVERAGE END : %ld ====================",(sum / times));
+	ESP_LOGI(DEBUGTAG, "===================== READ AVERAGE END : %" PRId32 " ====================",(int32_t)(sum / times));
 	return sum / times;
 }
 
-unsigned long HX711_get_value(char times) 
+int32_t HX711_get_value(char times) 
 {
-	unsigned long avg = HX711_read_average(times);
-	if(avg > OFFSET)
-		return avg - OFFSET;
-	else
-		return 0;
+	return HX711_read_average(times) - default_dev->offset[0];
 }
 
 float HX711_get_units(char times) 
 {
-	return HX711_get_value(times) / SCALE;
+	return HX711_get_value(times) / HX711_gain_to_scale(default_dev->gain_q[0]);
 }
 
 void HX711_tare( ) 
 {
 	ESP_LOGI(DEBUGTAG, "===================== START TARE ====================");
-	unsigned long sum = 0; 
-	sum = HX711_read_average(20);
-	HX711_set_offset(sum);
-	ESP_LOGI(DEBUGTAG, "===================== END TARE: %ld ====================",sum);
+	HX711_dev_tare(default_dev, 20);
+	ESP_LOGI(DEBUGTAG, "===================== END TARE: %" PRId32 " ====================",default_dev->offset[0]);
 }
 
 void HX711_set_scale(float scale ) 
 {
-	SCALE = scale;
+	default_dev->gain_q[0] = HX711_scale_to_gain(scale);
 }
 
 float HX711_get_scale()
  {
-	return SCALE;
+	return HX711_gain_to_scale(default_dev->gain_q[0]);
 }
 
-void HX711_set_offset(unsigned long offset)
+void HX711_set_offset(int32_t offset)
  {
-	OFFSET = offset;
+	default_dev->offset[0] = offset;
 }
 
-unsigned long HX711_get_offset(unsigned long offset) 
+int32_t HX711_get_offset() 
 {
-	return OFFSET;
+	return default_dev->offset[0];
 }
 
-void HX711_power_down() 
+void HX711_dev_power_down(HX711_dev_t *dev)
 {
-	gpio_set_level(GPIO_PD_SCK, LOW);
+	// holding PD_SCK high would corrupt a frame the acquisition task is clocking out
+	HX711_dev_stop_acquisition(dev);
+	while (dev->acq_task)
+	{
+		vTaskDelay(10 / portTICK_PERIOD_MS);
+	}
+	// PD_SCK has to stay high, which the SPI peripheral can't hold: give the pin back to the GPIO
+	if (dev->backend == eBACKEND_SPI)
+	{
+		gpio_set_level(dev->pd_sck, LOW);
+		esp_rom_gpio_connect_out_signal(dev->pd_sck, SIG_GPIO_OUT_IDX, false, false);
+	}
+	gpio_set_level(dev->pd_sck, LOW);
 	ets_delay_us(CLOCK_DELAY_US);
-	gpio_set_level(GPIO_PD_SCK, HIGH);
+	gpio_set_level(dev->pd_sck, HIGH);
 	ets_delay_us(CLOCK_DELAY_US);
 }
 
+void HX711_dev_power_up(HX711_dev_t *dev)
+{
+	gpio_set_level(dev->pd_sck, LOW);
+	if (dev->backend == eBACKEND_SPI)
+	{
+		esp_rom_gpio_connect_out_signal(dev->pd_sck, spi_periph_signal[HX711_SPI_HOST].spid_out, false, false);
+	}
+}
+
+void HX711_power_down() 
+{
+	HX711_dev_power_down(default_dev);
+}
+
 void HX711_power_up() 
 {
-	gpio_set_level(GPIO_PD_SCK, LOW);
-}
\ No newline at end of file
+	HX711_dev_power_up(default_dev);
+}
@@ -19,12 +19,23 @@ typedef enum HX711_GAIN
 	eGAIN_32 = 2
 }HX711_GAIN;
 
+// how PD_SCK pulses are generated when a conversion is clocked out
+typedef enum HX711_BACKEND
+{
+	eBACKEND_GPIO = 0,	// bit-banged inside a short critical section
+	eBACKEND_SPI = 1	// a spare SPI host shifts the whole frame; interrupts stay enabled
+}HX711_BACKEND;
+
 
 // define clock and data pin, channel, and gain factor
 // channel selection is made by passing the appropriate gain: 128 or 64 for channel A, 32 for channel B
 // gain: 128 or 64 for channel A; channel B works with 32 gain factor only
 void HX711_init(gpio_num_t dout, gpio_num_t pd_sck, HX711_GAIN gain);
 
+// same as HX711_init, choosing how frames are clocked out. eBACKEND_SPI takes over HX711_SPI_HOST
+// with PD_SCK on MOSI and DOUT on MISO; it falls back to eBACKEND_GPIO if the bus can't be set up
+void HX711_init_backend(gpio_num_t dout, gpio_num_t pd_sck, HX711_GAIN gain, HX711_BACKEND backend);
+
 
 // check if HX711 is ready
 // from the datasheet: When output data is not ready for retrieval, digital output pin DOUT is high. Serial clock
@@ -36,14 +47,18 @@ bool HX711_is_ready();
 // depending on the parameter, the channel is also set to either A or B
 void HX711_set_gain(HX711_GAIN gain);
 
-// waits for the chip to be ready and returns a reading
-unsigned long HX711_read();
+// the chip's 24-bit two's complement output as a signed value
+#define HX711_SIGN_EXTEND(v) ((int32_t)(((v) ^ 0x800000) - 0x800000))
+
+// waits for the chip to be ready and returns a signed 24-bit reading
+int32_t HX711_read();
 
 // returns an average reading; times = how many times to read
-unsigned long HX711_read_average(char times );
+int32_t HX711_read_average(char times );
 
-// returns (read_average() - OFFSET), that is the current value without the tare weight; times = how many readings to do
-unsigned long HX711_get_value(char times);
+// returns (read_average() - OFFSET), that is the current value without the tare weight; negative
+// when there is less on the platform than at tare. times = how many readings to do
+int32_t HX711_get_value(char times);
 
 // returns get_value() divided by SCALE, that is the raw value divided by a value obtained via calibration
 // times = how many readings to do
@@ -59,12 +74,102 @@ void HX711_set_scale(float scale );
 float HX711_get_scale();
 
 // set OFFSET, the value that's subtracted from the actual reading (tare weight)
-void HX711_set_offset(unsigned long offset);
+void HX711_set_offset(int32_t offset);
 
 // get the current OFFSET
-unsigned long HX711_get_offset();
+int32_t HX711_get_offset();
+
+// Calibration is kept in fixed point so conversions need no float:
+//   weight_mg = ((raw - offset) * gain_q) >> HX711_GAIN_Q
+// gain_q is milli-units per count. weight_mg is in thousandths of the calibrated unit, mg when
+// calibrated in grams. SCALE (counts per unit) converts to and from gain_q at the API edge
+#define HX711_GAIN_Q 16
+
+int32_t HX711_scale_to_gain(float scale);
+float HX711_gain_to_scale(int32_t gain_q);
+
+#define HX711_MAX_CHANNELS 4	// chips sharing one PD_SCK line
+
+// one conversion captured by the background acquisition
+typedef struct
+{
+	int64_t time_us;		// esp_timer time at which the last chip signalled data ready
+	int32_t raw[HX711_MAX_CHANNELS];	// per chip, same encoding as HX711_read()
+	int32_t weight_mg;		// calibrated channels summed, in milli-units
+} HX711_sample_t;
+
+#define HX711_RING_SIZE 32	// samples kept for readers; power of two
+
+// start background acquisition: a DOUT falling-edge interrupt wakes a task that clocks the
+// conversion out and stores it in a lock-free ring buffer. HX711_read() then returns the next
+// stored sample instead of clocking the chip itself
+void HX711_start_acquisition();
+
+// stop background acquisition
+void HX711_stop_acquisition();
+
+// cursor for HX711_next_sample() positioned after the newest stored sample
+uint32_t HX711_sample_cursor();
+
+// task to wake with xTaskNotifyGive after every stored sample, so a reader can block on
+// ulTaskNotifyTake instead of polling the ring; NULL for none
+void HX711_set_reader(TaskHandle_t reader);
+
+// never blocks: copies the sample after *cursor and advances it, or returns false if there is no
+// newer sample. A reader that fell more than HX711_RING_SIZE samples behind skips to the oldest
+// sample still stored. Any number of readers may poll, each with its own cursor
+bool HX711_next_sample(uint32_t *cursor, HX711_sample_t *sample);
+
+// Handle-based driver for platforms with several load cells. The chips share PD_SCK and each has
+// its own DOUT; one frame clocks all of them at once, so the sample rate stays that of a single
+// chip however many cells are fitted. The HX711_* functions above drive the instance created by
+// HX711_init(), and act on its first channel where they take a single value.
+typedef struct HX711_dev HX711_dev_t;
+
+typedef struct
+{
+	gpio_num_t pd_sck;							// shared clock
+	gpio_num_t dout[HX711_MAX_CHANNELS];		// one per chip
+	uint8_t channels;							// 1 to HX711_MAX_CHANNELS
+	HX711_GAIN gain;
+	HX711_BACKEND backend;						// eBACKEND_SPI drives a single channel only
+} HX711_config_t;
+
+// configure the pins and select the gain; returns NULL if the config is invalid or out of memory
+HX711_dev_t *HX711_open(const HX711_config_t *config);
+
+// stop acquisition, release the pins and free the handle
+void HX711_close(HX711_dev_t *dev);
+
+// the instance behind the single-chip functions, NULL before HX711_init()
+HX711_dev_t *HX711_default();
+
+uint8_t HX711_dev_channels(HX711_dev_t *dev);
+
+// waits until every chip is ready and reads them all in one frame; sample->weight_mg uses the
+// current calibration. Returns the next ring sample instead while acquisition runs
+void HX711_dev_read(HX711_dev_t *dev, HX711_sample_t *sample);
+
+// zero every channel on the average of `times` frames
+void HX711_dev_tare(HX711_dev_t *dev, uint8_t times);
+
+// per-channel calibration, see HX711_GAIN_Q
+void HX711_dev_set_calibration(HX711_dev_t *dev, uint8_t channel, int32_t offset, int32_t gain_q);
+void HX711_dev_get_calibration(HX711_dev_t *dev, uint8_t channel, int32_t *offset, int32_t *gain_q);
+
+void HX711_dev_start_acquisition(HX711_dev_t *dev);
+void HX711_dev_stop_acquisition(HX711_dev_t *dev);
+uint32_t HX711_dev_sample_cursor(HX711_dev_t *dev);
+void HX711_dev_set_reader(HX711_dev_t *dev, TaskHandle_t reader);
+bool HX711_dev_next_sample(HX711_dev_t *dev, uint32_t *cursor, HX711_sample_t *sample);
+
+// powers every chip on the shared clock down or up. Power down stops acquisition first and
+// waits for the task to finish its frame; power up doesn't restart it. The chips wake with
+// gain 128, so a different gain applies from the second conversion after power up
+void HX711_dev_power_down(HX711_dev_t *dev);
+void HX711_dev_power_up(HX711_dev_t *dev);
 
-// puts the chip into power down mode
+// puts the chip into power down mode, stopping acquisition first
 void HX711_power_down();
 
 // wakes up the chip after power down mode
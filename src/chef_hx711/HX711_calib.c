@@ -0,0 +1,257 @@
+#include "HX711_calib.h"
+#include <time.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "nvs.h"
+#include "soc/soc_caps.h"
+#if SOC_TEMP_SENSOR_SUPPORTED
+#include "driver/temperature_sensor.h"
+#endif
+
+#define CALIB_KEY "calib"
+#define VALID_TIME 1600000000	// anything earlier means SNTP never set the clock
+
+#define DEBUGTAG "HX711_calib"
+
+// what goes into NVS; the version guards against reading a layout written by other firmware
+typedef struct
+{
+	uint8_t version;
+	HX711_calib_t cal;
+} HX711_calib_record_t;
+
+static int64_t HX711_calib_now()
+{
+	time_t now = time(NULL);
+	return now >= VALID_TIME ? (int64_t)now : HX711_CALIB_NO_TIME;
+}
+
+static int8_t HX711_calib_temperature()
+{
+#if SOC_TEMP_SENSOR_SUPPORTED
+	temperature_sensor_handle_t sensor = NULL;
+	temperature_sensor_config_t config = TEMPERATURE_SENSOR_CONFIG_DEFAULT(-10, 80);
+	float celsius = HX711_CALIB_NO_TEMPERATURE;
+	if (temperature_sensor_install(&config, &sensor) == ESP_OK)
+	{
+		temperature_sensor_enable(sensor);
+		temperature_sensor_get_celsius(sensor, &celsius);
+		temperature_sensor_disable(sensor);
+		temperature_sensor_uninstall(sensor);
+	}
+	return (int8_t)celsius;
+#else
+	return HX711_CALIB_NO_TEMPERATURE;
+#endif
+}
+
+esp_err_t HX711_calib_load(HX711_calib_t *cal)
+{
+	nvs_handle_t nvs;
+	esp_err_t err = nvs_open(HX711_CALIB_NAMESPACE, NVS_READONLY, &nvs);
+	if (err != ESP_OK)
+	{
+		return err;
+	}
+
+	HX711_calib_record_t record;
+	size_t len = sizeof(record);
+	err = nvs_get_blob(nvs, CALIB_KEY, &record, &len);
+	nvs_close(nvs);
+	if (err == ESP_ERR_NVS_INVALID_LENGTH ||
+		(err == ESP_OK && (len != sizeof(record) || record.version != HX711_CALIB_VERSION)))
+	{
+		ESP_LOGW(DEBUGTAG, "Stored calibration has another layout, ignoring it");
+		return ESP_ERR_INVALID_VERSION;
+	}
+	if (err != ESP_OK)
+	{
+		return err;
+	}
+
+	*cal = record.cal;
+	return ESP_OK;
+}
+
+esp_err_t HX711_calib_save(const HX711_calib_t *cal)
+{
+	nvs_handle_t nvs;
+	esp_err_t err = nvs_open(HX711_CALIB_NAMESPACE, NVS_READWRITE, &nvs);
+	if (err != ESP_OK)
+	{
+		ESP_LOGE(DEBUGTAG, "Cannot open NVS: %s", esp_err_to_name(err));
+		return err;
+	}
+
+	HX711_calib_record_t record = {
+		.version = HX711_CALIB_VERSION,
+		.cal = *cal,
+	};
+	err = nvs_set_blob(nvs, CALIB_KEY, &record, sizeof(record));
+	if (err == ESP_OK)
+	{
+		err = nvs_commit(nvs);
+	}
+	nvs_close(nvs);
+	if (err != ESP_OK)
+	{
+		ESP_LOGE(DEBUGTAG, "Cannot save calibration: %s", esp_err_to_name(err));
+	}
+	return err;
+}
+
+esp_err_t HX711_calib_erase()
+{
+	nvs_handle_t nvs;
+	esp_err_t err = nvs_open(HX711_CALIB_NAMESPACE, NVS_READWRITE, &nvs);
+	if (err != ESP_OK)
+	{
+		return err;
+	}
+	err = nvs_erase_key(nvs, CALIB_KEY);
+	if (err == ESP_OK)
+	{
+		err = nvs_commit(nvs);
+	}
+	nvs_close(nvs);
+	return err;
+}
+
+void HX711_calib_apply(HX711_dev_t *dev, const HX711_calib_t *cal)
+{
+	uint8_t channels = HX711_dev_channels(dev);
+	for (uint8_t c = 0; c < channels && c < cal->channels; c++)
+	{
+		HX711_dev_set_calibration(dev, c, cal->offset[c], cal->gain_q[c]);
+	}
+}
+
+void HX711_calib_capture(HX711_dev_t *dev, HX711_calib_t *cal)
+{
+	memset(cal, 0, sizeof(*cal));
+	cal->channels = HX711_dev_channels(dev);
+	for (uint8_t c = 0; c < cal->channels; c++)
+	{
+		HX711_dev_get_calibration(dev, c, &cal->offset[c], &cal->gain_q[c]);
+	}
+	cal->scale_time = HX711_calib_now();
+	cal->zero_time = cal->scale_time;
+	cal->temperature_c = HX711_calib_temperature();
+}
+
+esp_err_t HX711_calib_save_zero(HX711_dev_t *dev, const int32_t *offset)
+{
+	HX711_calib_t cal;
+	if (HX711_calib_load(&cal) != ESP_OK)
+	{
+		// no stored scale yet: keep whatever the driver uses
+		HX711_calib_capture(dev, &cal);
+	}
+
+	cal.channels = HX711_dev_channels(dev);
+	for (uint8_t c = 0; c < cal.channels; c++)
+	{
+		int32_t old_offset;
+		HX711_dev_get_calibration(dev, c, &old_offset, &cal.gain_q[c]);
+		cal.offset[c] = offset[c];
+		HX711_dev_set_calibration(dev, c, offset[c], cal.gain_q[c]);
+	}
+	cal.zero_time = HX711_calib_now();
+	cal.temperature_c = HX711_calib_temperature();
+	return HX711_calib_save(&cal);
+}
+
+void HX711_calib_record_point(HX711_dev_t *dev, float weight, uint8_t times, HX711_calib_point_t *point)
+{
+	uint8_t channels = HX711_dev_channels(dev);
+	int64_t sum[HX711_MAX_CHANNELS] = { 0 };
+	HX711_sample_t sample;
+
+	if (times == 0)
+	{
+		times = 1;
+	}
+	for (uint8_t i = 0; i < times; i++)
+	{
+		HX711_dev_read(dev, &sample);
+		for (uint8_t c = 0; c < channels; c++)
+		{
+			sum[c] += sample.raw[c];
+		}
+	}
+
+	memset(point, 0, sizeof(*point));
+	point->weight = weight;
+	for (uint8_t c = 0; c < channels; c++)
+	{
+		point->raw[c] = sum[c] / times;
+	}
+	ESP_LOGI(DEBUGTAG, "Point %.1f: raw %" PRId32, weight, point->raw[0]);
+}
+
+esp_err_t HX711_calib_fit(HX711_dev_t *dev, const HX711_calib_point_t *points, uint8_t n)
+{
+	uint8_t channels = HX711_dev_channels(dev);
+	if (n < 2 || n > HX711_CALIB_MAX_POINTS)
+	{
+		return ESP_ERR_INVALID_ARG;
+	}
+
+	// raw = offset + scale * weight. Doubles: sums of squared 24-bit readings overflow a float's
+	// precision long before they overflow its range
+	double mean_w = 0;
+	double mean_raw[HX711_MAX_CHANNELS] = { 0 };
+	for (uint8_t i = 0; i < n; i++)
+	{
+		mean_w += points[i].weight;
+		for (uint8_t c = 0; c < channels; c++)
+		{
+			mean_raw[c] += points[i].raw[c];
+		}
+	}
+	mean_w /= n;
+	for (uint8_t c = 0; c < channels; c++)
+	{
+		mean_raw[c] /= n;
+	}
+
+	double sww = 0;
+	double swr = 0;		// against the sum of channels
+	for (uint8_t i = 0; i < n; i++)
+	{
+		double dw = points[i].weight - mean_w;
+		double dr = 0;
+		for (uint8_t c = 0; c < channels; c++)
+		{
+			dr += points[i].raw[c] - mean_raw[c];
+		}
+		sww += dw * dw;
+		swr += dw * dr;
+	}
+	if (sww == 0 || swr == 0)
+	{
+		ESP_LOGE(DEBUGTAG, "Calibration needs at least two different weights");
+		return ESP_ERR_INVALID_ARG;
+	}
+	double scale = swr / sww;	// counts per unit
+
+	// Each channel's intercept is its own zero. The intercepts add up to the intercept of the
+	// summed fit, so the calibrated channels sum to exactly that line
+	HX711_calib_t cal;
+	HX711_calib_capture(dev, &cal);
+	for (uint8_t c = 0; c < channels; c++)
+	{
+		double scw = 0;
+		for (uint8_t i = 0; i < n; i++)
+		{
+			scw += (points[i].weight - mean_w) * (points[i].raw[c] - mean_raw[c]);
+		}
+		double offset = mean_raw[c] - scw / sww * mean_w;
+		cal.offset[c] = (int32_t)(offset < 0 ? offset - 0.5 : offset + 0.5);
+		cal.gain_q[c] = HX711_scale_to_gain((float)scale);
+	}
+	ESP_LOGI(DEBUGTAG, "Fitted %d points: scale %.3f, offset %" PRId32, n, scale, cal.offset[0]);
+
+	HX711_calib_apply(dev, &cal);
+	return HX711_calib_save(&cal);
+}
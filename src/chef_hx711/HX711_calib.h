@@ -0,0 +1,61 @@
+#ifndef HX711_calib_h
+#define HX711_calib_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "HX711.h"
+
+// Calibration store. Offsets and scales live in NVS so the scale can show a reading from the
+// stored zero as soon as acquisition starts, instead of blocking on a tare first. NVS must
+// already be initialised (initialize_wifi does it at boot).
+
+#define HX711_CALIB_NAMESPACE "hx711"
+#define HX711_CALIB_VERSION 2
+
+#define HX711_CALIB_NO_TIME 0			// the wall clock wasn't set when the calibration was captured
+#define HX711_CALIB_NO_TEMPERATURE -128	// the chip has no temperature sensor
+
+typedef struct
+{
+	uint8_t channels;
+	int32_t offset[HX711_MAX_CHANNELS];		// zero reading per channel
+	int32_t gain_q[HX711_MAX_CHANNELS];		// milli-units per count, see HX711_GAIN_Q
+	int64_t scale_time;		// seconds since the epoch when the scale was calibrated
+	int64_t zero_time;		// same, for the offsets, which are refreshed far more often
+	int8_t temperature_c;	// die temperature when the offsets were captured
+} HX711_calib_t;
+
+// ESP_ERR_NVS_NOT_FOUND if nothing is stored; ESP_ERR_INVALID_VERSION if the stored layout is
+// from another firmware and has to be redone
+esp_err_t HX711_calib_load(HX711_calib_t *cal);
+esp_err_t HX711_calib_save(const HX711_calib_t *cal);
+esp_err_t HX711_calib_erase();
+
+// copy a calibration to or from the driver; channels the device doesn't have are ignored
+void HX711_calib_apply(HX711_dev_t *dev, const HX711_calib_t *cal);
+void HX711_calib_capture(HX711_dev_t *dev, HX711_calib_t *cal);
+
+// replace the stored offsets with `offset` and stamp them with the current time and temperature.
+// The scale is kept, so this is what a background re-zero calls
+esp_err_t HX711_calib_save_zero(HX711_dev_t *dev, const int32_t *offset);
+
+// Multi-point calibration: put known weights on the platform (including none), record a point
+// for each, then fit. Each channel gets the line through its own readings; all channels share
+// the slope of their sum, so a weight reads the same wherever it sits on a multi-cell platform.
+typedef struct
+{
+	float weight;								// known load, in display units
+	int32_t raw[HX711_MAX_CHANNELS];			// average reading with that load
+} HX711_calib_point_t;
+
+#define HX711_CALIB_MAX_POINTS 8
+
+// average `times` frames with `weight` on the platform
+void HX711_calib_record_point(HX711_dev_t *dev, float weight, uint8_t times, HX711_calib_point_t *point);
+
+// least-squares fit of the points; needs at least two distinct weights. On success the result
+// is applied to the device and written to the store
+esp_err_t HX711_calib_fit(HX711_dev_t *dev, const HX711_calib_point_t *points, uint8_t n);
+
+#endif
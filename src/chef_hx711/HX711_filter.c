@@ -0,0 +1,156 @@
+#include "HX711_filter.h"
+#include <stdlib.h>
+
+void HX711_median_init(HX711_median_t *m, uint8_t n)
+{
+	if (n < 1)
+		n = 1;
+	if (n > HX711_MEDIAN_MAX)
+		n = HX711_MEDIAN_MAX;
+	if ((n & 1) == 0)
+		n--;
+	m->n = n;
+	m->count = 0;
+	m->pos = 0;
+}
+
+int32_t HX711_median_push(HX711_median_t *m, int32_t x)
+{
+	m->history[m->pos] = x;
+	m->pos = (m->pos + 1) % m->n;
+	if (m->count < m->n)
+		m->count++;
+
+	// insertion sort of at most HX711_MEDIAN_MAX values
+	int32_t sorted[HX711_MEDIAN_MAX];
+	for (uint8_t i = 0; i < m->count; i++)
+	{
+		int32_t v = m->history[i];
+		int j = i;
+		while (j > 0 && sorted[j - 1] > v)
+		{
+			sorted[j] = sorted[j - 1];
+			j--;
+		}
+		sorted[j] = v;
+	}
+
+	// until the window fills, the lower middle of what's there
+	return sorted[(m->count - 1) / 2];
+}
+
+void HX711_ema_init(HX711_ema_t *e, int32_t alpha_q)
+{
+	e->alpha_q = alpha_q;
+	e->value = 0;
+	e->primed = false;
+}
+
+int32_t HX711_ema_push(HX711_ema_t *e, int32_t x)
+{
+	if (!e->primed)
+	{
+		e->value = x;
+		e->primed = true;
+	}
+	else
+	{
+		int64_t step = (int64_t)(x - e->value) * e->alpha_q;
+		e->value += (int32_t)((step + (1 << (HX711_ALPHA_Q - 1))) >> HX711_ALPHA_Q);
+	}
+	return e->value;
+}
+
+void HX711_stable_init(HX711_stable_t *s, int32_t band, uint8_t need)
+{
+	s->band = band;
+	s->need = need;
+	s->count = 0;
+	s->ref = 0;
+	s->stable = false;
+}
+
+HX711_STABLE_EVENT HX711_stable_push(HX711_stable_t *s, int32_t x)
+{
+	if (s->count == 0 || abs(x - s->ref) > s->band)
+	{
+		// start a new window at this sample
+		s->ref = x;
+		s->count = 1;
+		if (s->stable)
+		{
+			s->stable = false;
+			return eSTABLE_LOST;
+		}
+		return eSTABLE_NONE;
+	}
+
+	if (s->count < s->need)
+		s->count++;
+	if (!s->stable && s->count >= s->need)
+	{
+		s->stable = true;
+		return eSTABLE_SETTLED;
+	}
+	return eSTABLE_NONE;
+}
+
+void HX711_zero_track_init(HX711_zero_track_t *z, int32_t band, int32_t max_step)
+{
+	z->band = band;
+	z->max_step = max_step;
+	z->zero = 0;
+}
+
+void HX711_zero_track_update(HX711_zero_track_t *z, int32_t x, bool stable)
+{
+	if (z->band == 0 || !stable || abs(x) > z->band)
+		return;
+
+	int32_t step = x;
+	if (step > z->max_step)
+		step = z->max_step;
+	else if (step < -z->max_step)
+		step = -z->max_step;
+	z->zero += step;
+}
+
+void HX711_zero_track_reset(HX711_zero_track_t *z)
+{
+	z->zero = 0;
+}
+
+void HX711_filter_init(HX711_filter_t *f, uint8_t median_n, int32_t alpha_q, int32_t band, uint8_t need)
+{
+	HX711_median_init(&f->median, median_n);
+	HX711_ema_init(&f->ema, alpha_q);
+	HX711_zero_track_init(&f->zero, 0, 0);
+	HX711_stable_init(&f->stable, band, need);
+}
+
+void HX711_filter_set_zero_tracking(HX711_filter_t *f, int32_t band, int32_t max_step)
+{
+	f->zero.band = band;
+	f->zero.max_step = max_step;
+}
+
+HX711_filter_out_t HX711_filter_push(HX711_filter_t *f, int32_t x)
+{
+	HX711_filter_out_t out;
+	int32_t smoothed = HX711_ema_push(&f->ema, HX711_median_push(&f->median, x));
+	out.value = HX711_zero_track_apply(&f->zero, smoothed);
+	out.event = HX711_stable_push(&f->stable, out.value);
+	out.stable = f->stable.stable;
+	// moves by at most max_step, well inside the stability band, so tracking never unsettles
+	HX711_zero_track_update(&f->zero, out.value, out.stable);
+	return out;
+}
+
+void HX711_filter_reset(HX711_filter_t *f)
+{
+	f->median.count = 0;
+	f->median.pos = 0;
+	f->ema.primed = false;
+	f->stable.count = 0;
+	f->stable.stable = false;
+}
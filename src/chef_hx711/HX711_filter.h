@@ -0,0 +1,102 @@
+#ifndef HX711_filter_h
+#define HX711_filter_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Streaming filter for weight samples, one call per conversion. Stages can be used on their
+// own or chained by HX711_filter_push: median spike rejection, then an exponential moving
+// average, then zero tracking, then a stability detector. Nothing here touches the hardware. Samples are integers
+// (HX711_sample_t.weight_mg) and so is all the arithmetic.
+
+#define HX711_MEDIAN_MAX 9	// largest median window
+
+// median of the last n samples; a single spike never reaches the output for n >= 3
+typedef struct
+{
+	int32_t history[HX711_MEDIAN_MAX];
+	uint8_t n;			// window length, odd
+	uint8_t count;		// samples held, up to n
+	uint8_t pos;		// next slot to overwrite
+} HX711_median_t;
+
+void HX711_median_init(HX711_median_t *m, uint8_t n);
+int32_t HX711_median_push(HX711_median_t *m, int32_t x);
+
+// exponential moving average; alpha in (0, 1] as a Q HX711_ALPHA_Q fraction, larger follows faster
+#define HX711_ALPHA_Q 16
+#define HX711_ALPHA(a) ((int32_t)((a) * (1 << HX711_ALPHA_Q) + 0.5f))	// for constants
+
+typedef struct
+{
+	int32_t alpha_q;
+	int32_t value;
+	bool primed;		// false until the first sample, which is taken as is
+} HX711_ema_t;
+
+void HX711_ema_init(HX711_ema_t *e, int32_t alpha_q);
+int32_t HX711_ema_push(HX711_ema_t *e, int32_t x);
+
+typedef enum HX711_STABLE_EVENT
+{
+	eSTABLE_NONE = 0,
+	eSTABLE_SETTLED,	// the reading stayed within band for the last `need` samples
+	eSTABLE_LOST		// a settled reading moved out of band
+}HX711_STABLE_EVENT;
+
+// a reading is stable once `need` consecutive samples stay within +-band of the first of them
+typedef struct
+{
+	int32_t band;
+	uint8_t need;
+	uint8_t count;
+	int32_t ref;
+	bool stable;
+} HX711_stable_t;
+
+void HX711_stable_init(HX711_stable_t *s, int32_t band, uint8_t need);
+HX711_STABLE_EVENT HX711_stable_push(HX711_stable_t *s, int32_t x);
+
+// Automatic zero tracking: while the platform is empty and stable, follow the baseline as it
+// drifts with temperature and creep. A settled reading within +-band of zero moves the zero
+// toward itself by at most max_step per sample, so a slow pour outside the band is never
+// tracked away. band 0 disables tracking
+typedef struct
+{
+	int32_t band;
+	int32_t max_step;
+	int32_t zero;		// correction subtracted from every reading
+} HX711_zero_track_t;
+
+void HX711_zero_track_init(HX711_zero_track_t *z, int32_t band, int32_t max_step);
+static inline int32_t HX711_zero_track_apply(const HX711_zero_track_t *z, int32_t x) { return x - z->zero; }
+// x is the corrected reading, as returned by HX711_zero_track_apply
+void HX711_zero_track_update(HX711_zero_track_t *z, int32_t x, bool stable);
+// forget the correction, e.g. once it has been folded into the calibration offsets
+void HX711_zero_track_reset(HX711_zero_track_t *z);
+
+// the stages chained; zero tracking is off until HX711_filter_set_zero_tracking
+typedef struct
+{
+	HX711_median_t median;
+	HX711_ema_t ema;
+	HX711_zero_track_t zero;
+	HX711_stable_t stable;
+} HX711_filter_t;
+
+typedef struct
+{
+	int32_t value;				// filtered reading
+	bool stable;				// current stability state
+	HX711_STABLE_EVENT event;	// set on the sample where stability changed
+} HX711_filter_out_t;
+
+void HX711_filter_init(HX711_filter_t *f, uint8_t median_n, int32_t alpha_q, int32_t band, uint8_t need);
+void HX711_filter_set_zero_tracking(HX711_filter_t *f, int32_t band, int32_t max_step);
+HX711_filter_out_t HX711_filter_push(HX711_filter_t *f, int32_t x);
+
+// drop the history so old readings don't bleed into new ones. The zero correction is kept;
+// after a tare, also call HX711_zero_track_reset
+void HX711_filter_reset(HX711_filter_t *f);
+
+#endif
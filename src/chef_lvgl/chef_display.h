@@ -0,0 +1,8 @@
+#ifndef CHEF_DISPLAY_H
+#define CHEF_DISPLAY_H
+
+// Panel geometry (ST7735, portrait), shared by the driver and the screens
+#define SCREEN_WIDTH  128
+#define SCREEN_HEIGHT 160
+
+#endif
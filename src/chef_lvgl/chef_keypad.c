@@ -0,0 +1,149 @@
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "chef_keypad.h"
+#include "chef_ui_queue.h"
+
+#define KEY_QUEUE_LEN       16
+#define INPUT_TASK_STACK    3072
+#define INPUT_TASK_PRIORITY 5
+#define INPUT_TASK_CORE     0
+
+static const char *TAG = "KEYPAD";
+
+const chef_keymap_t chef_keymap_menu = {
+    .up = LV_KEY_PREV,
+    .down = LV_KEY_NEXT,
+    .select = LV_KEY_ENTER,
+};
+
+const chef_keymap_t chef_keymap_arrows = {
+    .up = LV_KEY_UP,
+    .down = LV_KEY_DOWN,
+    .select = LV_KEY_ENTER,
+};
+
+typedef struct {
+    uint32_t key;
+    bool pressed;
+} keypad_key_t;
+
+static lv_indev_t *keypad = NULL;
+static QueueHandle_t key_queue = NULL;  // input task -> indev read_cb
+
+// Written on the LVGL task by chef_keypad_attach, read by the input task
+static const chef_keymap_t * volatile keymap = &chef_keymap_menu;
+static const chef_input_handler_t * volatile screen_handlers = NULL;
+static const chef_input_handler_t *global_handlers = NULL;
+
+static uint32_t key_for_pin(const chef_keymap_t *map, int pin) {
+    switch (pin) {
+        case BTN_UP:     return map->up;
+        case BTN_DOWN:   return map->down;
+        case BTN_SELECT: return map->select;
+        case BTN_NEXT:   return map->next;
+        case BTN_PREV:   return map->prev;
+    }
+    return 0;
+}
+
+static const chef_input_handler_t *find_handler(const chef_input_handler_t *table,
+                                                const chef_button_event_t *event) {
+    for (; table && table->action; table++) {
+        if (table->pin == event->pin && table->type == event->type) {
+            return table;
+        }
+    }
+    return NULL;
+}
+
+static void keypad_read_now(void *arg) {
+    lv_indev_read(keypad);
+}
+
+// Only the key queue is read here; LVGL calls this from lv_indev_read on the
+// LVGL task. continue_reading drains a press and release queued together.
+static void keypad_read_cb(lv_indev_t *indev, lv_indev_data_t *data) {
+    static keypad_key_t last = { 0, false };
+
+    if (xQueueReceive(key_queue, &last, 0) == pdTRUE) {
+        data->continue_reading = uxQueueMessagesWaiting(key_queue) > 0;
+    }
+    data->key = last.key;
+    data->state = last.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+static void feed_key(uint32_t key, bool pressed) {
+    keypad_key_t k = { key, pressed };
+    if (xQueueSend(key_queue, &k, 0) != pdTRUE) {
+        ESP_LOGW(TAG, "Key queue full, dropping key %lu", key);
+        return;
+    }
+    chef_ui_call(keypad_read_now, NULL);
+}
+
+static void input_task_fn(void *params) {
+    chef_button_event_t event;
+    // Key LVGL sees as held and the button holding it. The release sends the
+    // same key even if a screen change swapped the keymap meanwhile.
+    uint32_t held_key = 0;
+    int held_pin = -1;
+
+    while (1) {
+        if (!chef_button_receive(&event, portMAX_DELAY)) {
+            continue;
+        }
+
+        const chef_input_handler_t *handler = find_handler(screen_handlers, &event);
+        if (!handler) {
+            handler = find_handler(global_handlers, &event);
+        }
+        if (handler) {
+            chef_ui_call(handler->action, handler->arg);
+            continue;
+        }
+
+        if (event.type == CHEF_BUTTON_PRESS && held_pin < 0) {
+            uint32_t key = key_for_pin(keymap, event.pin);
+            if (key != 0) {
+                held_key = key;
+                held_pin = event.pin;
+                feed_key(held_key, true);
+            }
+        } else if (event.type == CHEF_BUTTON_RELEASE && event.pin == held_pin) {
+            held_pin = -1;
+            feed_key(held_key, false);
+        }
+    }
+}
+
+void chef_keypad_init(const chef_input_handler_t *handlers) {
+    ESP_LOGI(TAG, "Creating keypad input device");
+    global_handlers = handlers;
+
+    key_queue = xQueueCreate(KEY_QUEUE_LEN, sizeof(keypad_key_t));
+    if (!key_queue) {
+        ESP_LOGE(TAG, "Failed to create key queue");
+        abort();
+    }
+
+    // Read only when the input task has queued a key, not on a polling timer
+    keypad = lv_indev_create();
+    lv_indev_set_type(keypad, LV_INDEV_TYPE_KEYPAD);
+    lv_indev_set_read_cb(keypad, keypad_read_cb);
+    lv_indev_set_mode(keypad, LV_INDEV_MODE_EVENT);
+
+    xTaskCreatePinnedToCore(input_task_fn, "input_task", INPUT_TASK_STACK, NULL,
+                            INPUT_TASK_PRIORITY, NULL, INPUT_TASK_CORE);
+}
+
+void chef_keypad_attach(lv_group_t *group, const chef_keymap_t *map,
+                        const chef_input_handler_t *handlers) {
+    keymap = map;
+    screen_handlers = handlers;
+    if (keypad) {
+        lv_indev_set_group(keypad, group);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef CHEF_KEYPAD_H
+#define CHEF_KEYPAD_H
+
+#include "lvgl.h"
+#include "../chef_buttons/chef_button.h"
+
+// The five buttons are an LVGL keypad input device. Each screen has its own
+// lv_group_t, so LVGL moves focus, scrolls and sends LV_EVENT_CLICKED itself.
+//
+// One input task, started once, owns the button event queue. It offers each
+// event to the active screen's handler table, then to the global table, and
+// otherwise translates it with the screen's keymap and feeds it to the indev.
+// Screen changes only swap the tables; no task is created or deleted.
+
+// LVGL key for each button; 0 leaves the button unused
+typedef struct {
+    uint32_t up;
+    uint32_t down;
+    uint32_t select;
+    uint32_t next;
+    uint32_t prev;
+} chef_keymap_t;
+
+extern const chef_keymap_t chef_keymap_menu;    // UP/DOWN move focus between buttons
+extern const chef_keymap_t chef_keymap_arrows;  // UP/DOWN go to the focused widget (scroll, spinbox)
+
+// Action bound to a button event. Tables end with an entry whose action is
+// NULL. Actions run on the LVGL task, after the input task matched them.
+typedef struct {
+    uint8_t pin;                  // BTN_*
+    uint8_t type;                 // chef_button_event_type_t
+    void (*action)(void *arg);
+    void *arg;
+} chef_input_handler_t;
+
+// Create the keypad indev and start the input task. global_handlers apply on
+// every screen. Call after lvgl_init_all, chef_ui_queue_init and setup_buttons.
+void chef_keypad_init(const chef_input_handler_t *global_handlers);
+
+// Route input to a screen: its group, keymap and handler table (may be NULL).
+// LVGL task only.
+void chef_keypad_attach(lv_group_t *group, const chef_keymap_t *keymap,
+                        const chef_input_handler_t *handlers);
+
+#endif
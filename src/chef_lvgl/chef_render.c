@@ -0,0 +1,67 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_task_wdt.h"
+#include "lvgl.h"
+#include "chef_render.h"
+#include "chef_ui_queue.h"
+
+#define RENDER_FRAME_BUDGET_MS LV_DEF_REFR_PERIOD
+#define RENDER_IDLE_MAX_MS     100
+#define RENDER_TASK_STACK      8192
+#define RENDER_TASK_PRIORITY   5
+#define RENDER_TASK_CORE       1
+
+static const char *TAG = "RENDER";
+
+static TaskHandle_t render_task = NULL;
+static volatile TickType_t last_frame_tick = 0;
+
+static void refr_ready_cb(lv_event_t * e) {
+    last_frame_tick = xTaskGetTickCount();
+}
+
+// Sleep until the next LVGL timer is due or a frame is requested. A request
+// is held back until one frame budget after the previous frame, so a burst of
+// changes is drawn once, then the display refresh timer is made ready.
+static void render_task_fn(void *params) {
+    ESP_ERROR_CHECK(esp_task_wdt_add(NULL));
+
+    lv_display_t *disp = lv_display_get_default();
+    lv_display_add_event_cb(disp, refr_ready_cb, LV_EVENT_REFR_READY, NULL);
+
+    while (1) {
+        chef_ui_queue_drain();
+        uint32_t idle_ms = lv_timer_handler();
+        esp_task_wdt_reset();
+
+        if (idle_ms == LV_NO_TIMER_READY || idle_ms > RENDER_IDLE_MAX_MS) {
+            idle_ms = RENDER_IDLE_MAX_MS;
+        }
+        TickType_t idle_ticks = pdMS_TO_TICKS(idle_ms);
+        if (idle_ticks == 0) {
+            idle_ticks = 1;
+        }
+
+        if (ulTaskNotifyTake(pdTRUE, idle_ticks) > 0) {
+            TickType_t since_frame = xTaskGetTickCount() - last_frame_tick;
+            if (since_frame < pdMS_TO_TICKS(RENDER_FRAME_BUDGET_MS)) {
+                vTaskDelay(pdMS_TO_TICKS(RENDER_FRAME_BUDGET_MS) - since_frame);
+            }
+            ulTaskNotifyTake(pdTRUE, 0);
+            lv_timer_ready(lv_display_get_refr_timer(disp));
+        }
+    }
+}
+
+void chef_render_start(void) {
+    ESP_LOGI(TAG, "Starting render task");
+    xTaskCreatePinnedToCore(render_task_fn, "lvgl_handler", RENDER_TASK_STACK, NULL,
+                            RENDER_TASK_PRIORITY, &render_task, RENDER_TASK_CORE);
+}
+
+void chef_render_request(void) {
+    if (render_task) {
+        xTaskNotifyGive(render_task);
+    }
+}
@@ -0,0 +1,13 @@
+#ifndef CHEF_RENDER_H
+#define CHEF_RENDER_H
+
+// Start the LVGL task. It applies queued UI commands (chef_ui_queue.h), runs
+// lv_timer_handler and is the only task that renders.
+void chef_render_start(void);
+
+// Mark that widgets changed and a frame is wanted soon. Requests arriving within
+// one frame budget coalesce into a single refresh on the LVGL task. Safe to call
+// from any task.
+void chef_render_request(void);
+
+#endif
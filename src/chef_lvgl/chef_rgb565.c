@@ -0,0 +1,18 @@
+#include "chef_rgb565.h"
+
+// Two pixels per 32-bit word
+void chef_rgb565_swap(uint8_t *px_map, size_t px_count)
+{
+    uint32_t *words = (uint32_t *)px_map;
+    size_t word_count = px_count / 2;
+
+    for (size_t i = 0; i < word_count; i++) {
+        uint32_t w = words[i];
+        words[i] = ((w & 0xFF00FF00u) >> 8) | ((w & 0x00FF00FFu) << 8);
+    }
+
+    if (px_count & 1) {
+        uint16_t *last = (uint16_t *)px_map + px_count - 1;
+        *last = (uint16_t)((*last << 8) | (*last >> 8));
+    }
+}
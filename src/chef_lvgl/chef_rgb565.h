@@ -0,0 +1,17 @@
+#ifndef CHEF_RGB565_H
+#define CHEF_RGB565_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Convert LVGL's little-endian RGB565 to the panel's big-endian order in place.
+// px_map must be 4-byte aligned, as draw buffers are.
+//
+// This was the ST7735 flush's own swap. The host benchmark (src/chef_host)
+// times it against lv_draw_sw_rgb565_swap, which does the same per word but
+// unrolled by eight: on x86-64 that one took 0.09-0.13 ns/px against 0.5-0.7
+// at -O2, and 0.52 against 0.72 at -Os, so the flush now calls LVGL's. Kept as
+// the baseline; switch back if the benchmark ever says otherwise.
+void chef_rgb565_swap(uint8_t *px_map, size_t px_count);
+
+#endif
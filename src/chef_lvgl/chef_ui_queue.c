@@ -0,0 +1,120 @@
+#include <stdatomic.h>
+#include <string.h>
+#include "esp_log.h"
+#include "chef_ui_queue.h"
+#include "chef_render.h"
+
+// Bounded multi-producer/single-consumer ring (Vyukov). Each slot carries a
+// sequence number: seq == pos means free for the producer claiming pos,
+// seq == pos + 1 means filled and ready for the consumer.
+#define UI_QUEUE_SIZE 32  // power of two
+
+static const char *TAG = "UI_QUEUE";
+
+typedef struct {
+    atomic_uint seq;
+    chef_ui_cmd_t cmd;
+} ui_slot_t;
+
+static ui_slot_t slots[UI_QUEUE_SIZE];
+static atomic_uint enqueue_pos;
+static unsigned int dequeue_pos;  // consumer only
+
+void chef_ui_queue_init(void) {
+    for (unsigned int i = 0; i < UI_QUEUE_SIZE; i++) {
+        atomic_init(&slots[i].seq, i);
+    }
+    atomic_init(&enqueue_pos, 0);
+    dequeue_pos = 0;
+}
+
+static bool ui_queue_push(const chef_ui_cmd_t *cmd) {
+    ui_slot_t *slot;
+    unsigned int pos = atomic_load_explicit(&enqueue_pos, memory_order_relaxed);
+
+    while (1) {
+        slot = &slots[pos & (UI_QUEUE_SIZE - 1)];
+        unsigned int seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        int diff = (int)(seq - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            ESP_LOGW(TAG, "Queue full, dropping command %d", cmd->type);
+            return false;
+        } else {
+            pos = atomic_load_explicit(&enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    slot->cmd = *cmd;
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    chef_render_request();
+    return true;
+}
+
+static bool ui_queue_pop(chef_ui_cmd_t *cmd) {
+    ui_slot_t *slot = &slots[dequeue_pos & (UI_QUEUE_SIZE - 1)];
+    unsigned int seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    if ((int)(seq - (dequeue_pos + 1)) < 0) {
+        return false;
+    }
+
+    *cmd = slot->cmd;
+    atomic_store_explicit(&slot->seq, dequeue_pos + UI_QUEUE_SIZE, memory_order_release);
+    dequeue_pos++;
+    return true;
+}
+
+bool chef_ui_set_text(lv_obj_t *label, const char *text) {
+    chef_ui_cmd_t cmd = { .type = CHEF_UI_CMD_SET_TEXT, .obj = label };
+    strncpy(cmd.text, text, CHEF_UI_TEXT_MAX - 1);
+    return ui_queue_push(&cmd);
+}
+
+bool chef_ui_send_event(lv_obj_t *obj, lv_event_code_t code) {
+    chef_ui_cmd_t cmd = { .type = CHEF_UI_CMD_SEND_EVENT, .obj = obj, .event = code };
+    return ui_queue_push(&cmd);
+}
+
+bool chef_ui_load_screen(void (*navigate)(void)) {
+    chef_ui_cmd_t cmd = { .type = CHEF_UI_CMD_LOAD_SCREEN, .navigate = navigate };
+    return ui_queue_push(&cmd);
+}
+
+bool chef_ui_call(void (*fn)(void *arg), void *arg) {
+    chef_ui_cmd_t cmd = { .type = CHEF_UI_CMD_CALL, .call = { fn, arg } };
+    return ui_queue_push(&cmd);
+}
+
+static void ui_cmd_apply(const chef_ui_cmd_t *cmd) {
+    // A navigation earlier in the queue may have deleted the target
+    if (cmd->obj && !lv_obj_is_valid(cmd->obj)) {
+        return;
+    }
+
+    switch (cmd->type) {
+        case CHEF_UI_CMD_SET_TEXT:
+            lv_label_set_text(cmd->obj, cmd->text);
+            break;
+        case CHEF_UI_CMD_SEND_EVENT:
+            lv_obj_send_event(cmd->obj, cmd->event, NULL);
+            break;
+        case CHEF_UI_CMD_LOAD_SCREEN:
+            cmd->navigate();
+            break;
+        case CHEF_UI_CMD_CALL:
+            cmd->call.fn(cmd->call.arg);
+            break;
+    }
+}
+
+void chef_ui_queue_drain(void) {
+    chef_ui_cmd_t cmd;
+    // Bounded so producers cannot keep the LVGL task from rendering
+    for (int i = 0; i < UI_QUEUE_SIZE && ui_queue_pop(&cmd); i++) {
+        ui_cmd_apply(&cmd);
+    }
+}
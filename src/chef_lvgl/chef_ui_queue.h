@@ -0,0 +1,46 @@
+#ifndef CHEF_UI_QUEUE_H
+#define CHEF_UI_QUEUE_H
+
+#include <stdbool.h>
+#include "lvgl.h"
+
+// LVGL is not thread safe (LV_USE_OS is LV_OS_NONE), so tasks other than the
+// LVGL task post typed commands here instead of touching widgets. The LVGL task
+// drains the queue once per frame. Posting never blocks or allocates; it returns
+// false if the queue is full and the command is dropped.
+
+#define CHEF_UI_TEXT_MAX 24
+
+typedef enum {
+    CHEF_UI_CMD_SET_TEXT,       // lv_label_set_text
+    CHEF_UI_CMD_SEND_EVENT,     // lv_obj_send_event
+    CHEF_UI_CMD_LOAD_SCREEN,    // run a navigation function
+    CHEF_UI_CMD_CALL,           // run any function on the LVGL task
+} chef_ui_cmd_type_t;
+
+typedef struct {
+    chef_ui_cmd_type_t type;
+    lv_obj_t *obj;
+    union {
+        char text[CHEF_UI_TEXT_MAX];
+        lv_event_code_t event;
+        void (*navigate)(void);
+        struct {
+            void (*fn)(void *arg);
+            void *arg;
+        } call;
+    };
+} chef_ui_cmd_t;
+
+// Reset the queue; call once before any task posts
+void chef_ui_queue_init(void);
+
+bool chef_ui_set_text(lv_obj_t *label, const char *text);
+bool chef_ui_send_event(lv_obj_t *obj, lv_event_code_t code);
+bool chef_ui_load_screen(void (*navigate)(void));
+bool chef_ui_call(void (*fn)(void *arg), void *arg);
+
+// Apply pending commands in order. LVGL task only.
+void chef_ui_queue_drain(void);
+
+#endif
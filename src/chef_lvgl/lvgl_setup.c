@@ -4,9 +4,14 @@
 #include "freertos/task.h"
 #include "driver/spi_master.h"
 #include "driver/gpio.h"
+#include "hal/gpio_ll.h"
+#include "soc/gpio_struct.h"
 #include "esp_log.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
 #include "lvgl.h"
 #include "lv_conf.h"
+#include "chef_display.h"
 
 // Pin definitions
 #define PIN_MOSI 18 
@@ -17,8 +22,15 @@
 #define PIN_BL   4  // Backlight pin
 
 // Display dimensions
-#define ST7735_WIDTH  128
-#define ST7735_HEIGHT 160
+#define ST7735_WIDTH  SCREEN_WIDTH
+#define ST7735_HEIGHT SCREEN_HEIGHT
+
+#ifndef CHEF_DRAW_BUF_LINES
+#define CHEF_DRAW_BUF_LINES 20
+#endif
+
+// Bytes in one RGB565 draw buffer strip
+#define DRAW_BUF_SIZE (ST7735_WIDTH * CHEF_DRAW_BUF_LINES * 2)
 
 // ST7735 commands
 #define ST7735_NOP     0x00
@@ -32,10 +44,25 @@
 #define ST7735_MADCTL  0x36
 #define ST7735_COLMOD  0x3A
 
+// Flags carried in spi_transaction_t.user
+#define TRANS_DC_DATA     (1 << 0)  // DC high: data, otherwise command
+
+// CASET + data, RASET + data, RAMWR, pixels
+#define FLUSH_TRANS_COUNT 6
 
 static const char *TAG = "ST7735";
 static spi_device_handle_t spi;
 
+static spi_transaction_t flush_trans[FLUSH_TRANS_COUNT];
+static int flush_trans_pending = 0;
+
+// Drive DC for the transaction about to start. CONFIG_SPI_MASTER_ISR_IN_IRAM
+// keeps this ISR running while the flash cache is off (NVS writes), so it may
+// only touch IRAM: gpio_ll_set_level is inline, gpio_set_level is in flash.
+static void IRAM_ATTR spi_pre_transfer_cb(spi_transaction_t *t) {
+    gpio_ll_set_level(&GPIO, PIN_DC, ((uint32_t)t->user & TRANS_DC_DATA) ? 1 : 0);
+}
+
 // Initialize GPIO
 static void gpio_init(void) {
     gpio_set_direction(PIN_DC, GPIO_MODE_OUTPUT);
@@ -64,7 +91,7 @@ void tft_cmd(const uint8_t cmd) {
     t.length = 8;
     t.tx_data[0] = cmd;
     t.flags = SPI_TRANS_USE_TXDATA;
-    gpio_set_level(PIN_DC, 0);  // Command mode
+    t.user = (void *)0;  // Command mode
     ret = spi_device_polling_transmit(spi, &t);
     assert(ret == ESP_OK);
 }
@@ -84,7 +111,7 @@ void tft_data(const uint8_t *data, int len) {
         memset(&t, 0, sizeof(t));
         t.length = current_len * 8;
         t.tx_buffer = data_ptr;
-        gpio_set_level(PIN_DC, 1);
+        t.user = (void *)TRANS_DC_DATA;
         esp_err_t ret = spi_device_polling_transmit(spi, &t);
         assert(ret == ESP_OK);
 
@@ -101,6 +128,7 @@ static void spi_init() {
         .sclk_io_num = PIN_SCLK,
         .quadwp_io_num = -1,
         .quadhd_io_num = -1,
+        .max_transfer_sz = DRAW_BUF_SIZE,
     };
 
     spi_device_interface_config_t devcfg={
@@ -110,8 +138,7 @@ static void spi_init() {
         .spics_io_num=PIN_CS,
         .flags = SPI_DEVICE_HALFDUPLEX,
         .queue_size=7,
-        .pre_cb=NULL,
-        .post_cb=NULL,
+        .pre_cb=spi_pre_transfer_cb,
     };
 
     ESP_ERROR_CHECK(spi_bus_initialize(HSPI_HOST, &buscfg, SPI_DMA_CH_AUTO));
@@ -201,16 +228,79 @@ void st7735_clear_display() {
 }
 
 
+// Collect the transactions queued by the previous flush
+static void flush_wait_pending(void) {
+    spi_transaction_t *done;
+    while (flush_trans_pending > 0) {
+        esp_err_t ret = spi_device_get_trans_result(spi, &done, portMAX_DELAY);
+        assert(ret == ESP_OK);
+        flush_trans_pending--;
+    }
+}
+
+static void flush_trans_set_cmd(spi_transaction_t *t, uint8_t cmd) {
+    memset(t, 0, sizeof(*t));
+    t->length = 8;
+    t->tx_data[0] = cmd;
+    t->flags = SPI_TRANS_USE_TXDATA;
+    t->user = (void *)0;
+}
+
+static void flush_trans_set_range(spi_transaction_t *t, uint16_t start, uint16_t end) {
+    memset(t, 0, sizeof(*t));
+    t->length = 4 * 8;
+    t->tx_data[0] = (start >> 8) & 0xFF;
+    t->tx_data[1] = start & 0xFF;
+    t->tx_data[2] = (end >> 8) & 0xFF;
+    t->tx_data[3] = end & 0xFF;
+    t->flags = SPI_TRANS_USE_TXDATA;
+    t->user = (void *)TRANS_DC_DATA;
+}
+
+// Queue the window setup and pixel data without waiting for the bus, so LVGL
+// can render the next area into the other buffer while this one is sent.
+// LVGL waits for it in display_flush_wait_cb before reusing the buffer.
 static void display_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
 {
     size_t width = area->x2 - area->x1 + 1;
     size_t height = area->y2 - area->y1 + 1;
 
-    st7735_set_window(area->x1, area->y1, area->x2, area->y2);
+    // LVGL's unrolled swap: faster than chef_rgb565_swap, see chef_rgb565.h
+    lv_draw_sw_rgb565_swap(px_map, width * height);
 
-    tft_data(px_map, width * height * 2);
+    flush_wait_pending();
 
-    lv_display_flush_ready(disp);
+    flush_trans_set_cmd(&flush_trans[0], ST7735_CASET);
+    flush_trans_set_range(&flush_trans[1], area->x1, area->x2);
+    flush_trans_set_cmd(&flush_trans[2], ST7735_RASET);
+    flush_trans_set_range(&flush_trans[3], area->y1, area->y2);
+    flush_trans_set_cmd(&flush_trans[4], ST7735_RAMWR);
+
+    spi_transaction_t *px = &flush_trans[5];
+    memset(px, 0, sizeof(*px));
+    px->length = width * height * 2 * 8;
+    px->tx_buffer = px_map;
+    px->user = (void *)TRANS_DC_DATA;
+
+    for (int i = 0; i < FLUSH_TRANS_COUNT; i++) {
+        esp_err_t ret = spi_device_queue_trans(spi, &flush_trans[i], portMAX_DELAY);
+        assert(ret == ESP_OK);
+        flush_trans_pending++;
+    }
+}
+
+// Runs on the LVGL task in place of spinning on lv_display_flush_ready, which
+// would otherwise have to be called from the SPI ISR
+static void display_flush_wait_cb(lv_display_t * disp)
+{
+    flush_wait_pending();
+}
+
+// LVGL's clock. Without it lv_tick_get stays 0: lv_timer_handler's "next timer
+// due" is meaningless to chef_render and animations never advance.
+static uint32_t lvgl_tick_cb(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
 }
 
 void lvgl_init_all(){
@@ -221,15 +311,23 @@ void lvgl_init_all(){
     ESP_LOGI(TAG, "Starting LVGL");
 
     lv_init();
-
-    static lv_color_t buf1[ST7735_WIDTH * ST7735_HEIGHT] = {0};  // Declare a buffer for 10 lines
+    lv_tick_set_cb(lvgl_tick_cb);
+
+    // Two strips: LVGL renders into one while the other is sent by DMA
+    void *buf1 = heap_caps_malloc(DRAW_BUF_SIZE, MALLOC_CAP_DMA);
+    void *buf2 = heap_caps_malloc(DRAW_BUF_SIZE, MALLOC_CAP_DMA);
+    if (!buf1 || !buf2) {
+        ESP_LOGE(TAG, "Failed to allocate %d line draw buffers", CHEF_DRAW_BUF_LINES);
+        abort();
+    }
     
     // Create a display
     lv_display_t * display = lv_display_create(ST7735_WIDTH, ST7735_HEIGHT);
-    lv_display_set_buffers(display, buf1, NULL, sizeof(buf1), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_color_format(display, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_buffers(display, buf1, buf2, DRAW_BUF_SIZE, LV_DISPLAY_RENDER_MODE_PARTIAL);
     lv_display_set_flush_cb(display, display_flush_cb);
+    lv_display_set_flush_wait_cb(display, display_flush_wait_cb);
     lv_display_set_rotation(display, LV_DISPLAY_ROTATION_0);
-    lv_display_set_color_format(display, LV_COLOR_FORMAT_RGB565);
 
     lv_disp_t* disp = lv_disp_get_default();
     if (!disp) {
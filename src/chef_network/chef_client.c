@@ -2,30 +2,45 @@
 #include "esp_log.h"
 #include <string.h>
 #include "chef_client.h"
+#include "../chef_pack/chef_pack_store.h"
 #include "esp_crt_bundle.h"
 
-#define MAX_HTTP_OUTPUT_BUFFER 2048
-
 static const char *TAG = "HTTP_CLIENT";
 
-// Buffer to store response
-char output_buffer[MAX_HTTP_OUTPUT_BUFFER] = {0};
-int output_len = 0;
-cJSON* recipes_json;
+typedef struct {
+    bool receiving;     // chef_pack_store_receive_begin done
+    bool failed;
+    int body_len;
+} fetch_ctx_t;
 
-cJSON* fetch_recipe_json(){
-    return recipes_json;
+const chef_pack_t* fetch_recipe_pack(){
+    return chef_pack_store_get();
 }
 
+// Chunked or not, the client hands over the decoded body piece by piece; each
+// piece goes straight to flash, nothing is buffered or parsed here. Only a 200
+// body is the pack: a redirect's body arrives here too before it is followed,
+// and an error page must not cost the spare slot an erase.
 esp_err_t _http_event_handler(esp_http_client_event_t *evt)
 {
+    fetch_ctx_t *ctx = evt->user_data;
     switch(evt->event_id) {
         case HTTP_EVENT_ON_DATA:
-            if (!esp_http_client_is_chunked_response(evt->client)) {
-                if (output_len + evt->data_len < MAX_HTTP_OUTPUT_BUFFER) {
-                    memcpy(output_buffer + output_len, evt->data, evt->data_len);
-                    output_len += evt->data_len;
+            if (esp_http_client_get_status_code(evt->client) != 200 || ctx->failed) {
+                break;
+            }
+            if (!ctx->receiving) {
+                esp_err_t err = chef_pack_store_receive_begin();
+                if (err != ESP_OK) {
+                    ESP_LOGE(TAG, "Cannot store recipes: %s", esp_err_to_name(err));
+                    ctx->failed = true;
+                    break;
                 }
+                ctx->receiving = true;
+            }
+            ctx->body_len += evt->data_len;
+            if (chef_pack_store_receive(evt->data, evt->data_len) != ESP_OK) {
+                ctx->failed = true;
             }
             break;
         default:
@@ -36,12 +51,12 @@ esp_err_t _http_event_handler(esp_http_client_event_t *evt)
 
 void fetch_github_json()
 {
-    memset(output_buffer, 0, MAX_HTTP_OUTPUT_BUFFER);
-    output_len = 0;
-    
+    fetch_ctx_t ctx = { 0 };
+
     esp_http_client_config_t config = {
-        .url = "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx", //replace with URL
+        .url = "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx", //replace with URL of the recipes.pack built by chef_packc
         .event_handler = _http_event_handler,
+        .user_data = &ctx,
         .crt_bundle_attach = esp_crt_bundle_attach,
     };
     
@@ -49,25 +64,23 @@ void fetch_github_json()
     esp_err_t err = esp_http_client_perform(client);
 
     if (err == ESP_OK) {
-        ESP_LOGI(TAG, "HTTP GET Status = %d", esp_http_client_get_status_code(client));
-        ESP_LOGI(TAG, "Content length = %d", output_len);
-        ESP_LOGI(TAG, "Raw response: %s", output_buffer);
-        
-        recipes_json = cJSON_Parse(output_buffer);
-        if (recipes_json != NULL) {
-            char* printed = cJSON_Print(recipes_json);
-            if (printed) {
-                ESP_LOGI(TAG, "Parsed JSON: %s", printed);
-                free(printed);
-            } else {
-                ESP_LOGE(TAG, "Failed to print JSON");
+        int status = esp_http_client_get_status_code(client);
+        ESP_LOGI(TAG, "HTTP GET Status = %d", status);
+        ESP_LOGI(TAG, "Content length = %d%s", ctx.body_len,
+                 esp_http_client_is_chunked_response(client) ? " (chunked)" : "");
+
+        // keep the previous catalog unless the new one arrived whole and verifies
+        if (status == 200 && ctx.receiving && !ctx.failed) {
+            err = chef_pack_store_receive_commit();
+            if (err != ESP_OK) {
+                ESP_LOGE(TAG, "Recipe pack rejected: %s", esp_err_to_name(err));
             }
         } else {
-            ESP_LOGE(TAG, "JSON Parse Error: %s", cJSON_GetErrorPtr());
+            ESP_LOGE(TAG, "Recipe pack download failed, keeping the previous one");
         }
     } else {
         ESP_LOGE(TAG, "HTTP GET failed: %s", esp_err_to_name(err));
     }
     
     esp_http_client_cleanup(client);
-}
\ No newline at end of file
+}
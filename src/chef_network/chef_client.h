@@ -1,4 +1,6 @@
-#include "cJSON.h"
+#include "../chef_pack/chef_pack.h"
 
+// Download the recipe pack; a failed download keeps the previous one.
 void fetch_github_json();
-cJSON* fetch_recipe_json();
\ No newline at end of file
+// NULL if no catalog has ever been downloaded.
+const chef_pack_t* fetch_recipe_pack();
\ No newline at end of file
@@ -0,0 +1,363 @@
+#include <string.h>
+#include "chef_json_stream.h"
+
+enum {
+    S_VALUE,            // a value is expected
+    S_VALUE_OR_END,     // after '[': a value or ']'
+    S_KEY_OR_END,       // after '{': a member name or '}'
+    S_KEY,              // after ',' in an object
+    S_COLON,
+    S_COMMA_OR_END,     // after a value inside a container
+    S_STRING,
+    S_ESCAPE,
+    S_UNICODE,
+    S_NUMBER,
+    S_LITERAL,          // true, false, null
+    S_DONE,             // the root value is complete, only whitespace may follow
+    S_ERROR,
+};
+
+void chef_json_stream_init(chef_json_stream_t *s, chef_json_cb_t cb, void *ctx) {
+    memset(s, 0, sizeof(*s));
+    s->cb = cb;
+    s->ctx = ctx;
+    s->state = S_VALUE;
+}
+
+static bool fail(chef_json_stream_t *s, chef_json_error_t error) {
+    s->error = error;
+    s->state = S_ERROR;
+    return false;
+}
+
+static bool emit(chef_json_stream_t *s, chef_json_event_t event, int depth) {
+    s->tok[s->tok_len] = '\0';
+    bool ok = s->cb(event, s->tok, s->tok_len, depth, s->ctx);
+    s->tok_len = 0;
+    return ok || fail(s, CHEF_JSON_ERR_ABORTED);
+}
+
+static bool push_byte(chef_json_stream_t *s, char c) {
+    if (s->tok_len >= CHEF_JSON_TOKEN_MAX - 1) {
+        return fail(s, CHEF_JSON_ERR_TOKEN);
+    }
+    s->tok[s->tok_len++] = c;
+    return true;
+}
+
+static bool push_utf8(chef_json_stream_t *s, uint32_t cp) {
+    if (cp < 0x80) {
+        return push_byte(s, cp);
+    }
+    if (cp < 0x800) {
+        return push_byte(s, 0xC0 | (cp >> 6)) && push_byte(s, 0x80 | (cp & 0x3F));
+    }
+    if (cp < 0x10000) {
+        return push_byte(s, 0xE0 | (cp >> 12)) && push_byte(s, 0x80 | ((cp >> 6) & 0x3F)) &&
+               push_byte(s, 0x80 | (cp & 0x3F));
+    }
+    return push_byte(s, 0xF0 | (cp >> 18)) && push_byte(s, 0x80 | ((cp >> 12) & 0x3F)) &&
+           push_byte(s, 0x80 | ((cp >> 6) & 0x3F)) && push_byte(s, 0x80 | (cp & 0x3F));
+}
+
+static void value_done(chef_json_stream_t *s) {
+    s->state = s->depth == 0 ? S_DONE : S_COMMA_OR_END;
+}
+
+static bool top_is_object(const chef_json_stream_t *s) {
+    return s->objects & (1u << (s->depth - 1));
+}
+
+static bool open_container(chef_json_stream_t *s, bool object) {
+    if (s->depth >= CHEF_JSON_MAX_DEPTH) {
+        return fail(s, CHEF_JSON_ERR_DEPTH);
+    }
+    if (object) {
+        s->objects |= 1u << s->depth;
+    } else {
+        s->objects &= ~(1u << s->depth);
+    }
+    s->depth++;
+    s->state = object ? S_KEY_OR_END : S_VALUE_OR_END;
+    return emit(s, object ? CHEF_JSON_OBJECT_START : CHEF_JSON_ARRAY_START, s->depth);
+}
+
+static bool close_container(chef_json_stream_t *s, bool object) {
+    int depth = s->depth--;
+    value_done(s);
+    return emit(s, object ? CHEF_JSON_OBJECT_END : CHEF_JSON_ARRAY_END, depth);
+}
+
+static bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static bool end_literal(chef_json_stream_t *s) {
+    static const struct {
+        const char *text;
+        chef_json_event_t event;
+    } literals[] = {
+        { "true", CHEF_JSON_TRUE },
+        { "false", CHEF_JSON_FALSE },
+        { "null", CHEF_JSON_NULL },
+    };
+    for (size_t i = 0; i < sizeof(literals) / sizeof(literals[0]); i++) {
+        if (s->tok_len == strlen(literals[i].text) &&
+            memcmp(s->tok, literals[i].text, s->tok_len) == 0) {
+            value_done(s);
+            return emit(s, literals[i].event, s->depth);
+        }
+    }
+    return fail(s, CHEF_JSON_ERR_SYNTAX);
+}
+
+static const char *skip_digits(const char *p, const char *end) {
+    while (p < end && *p >= '0' && *p <= '9') {
+        p++;
+    }
+    return p;
+}
+
+// S_NUMBER collects any run of number characters; this holds it to the JSON
+// grammar: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+static bool is_number(const char *p, size_t len) {
+    const char *end = p + len;
+    if (p < end && *p == '-') {
+        p++;
+    }
+    const char *digits = p;
+    p = skip_digits(p, end);
+    if (p == digits || (*digits == '0' && p - digits > 1)) {
+        return false;
+    }
+    if (p < end && *p == '.') {
+        digits = ++p;
+        p = skip_digits(p, end);
+        if (p == digits) {
+            return false;
+        }
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        if (++p < end && (*p == '+' || *p == '-')) {
+            p++;
+        }
+        digits = p;
+        p = skip_digits(p, end);
+        if (p == digits) {
+            return false;
+        }
+    }
+    return p == end;
+}
+
+static bool step(chef_json_stream_t *s, char c);
+
+// A number or literal has no closing delimiter: it ends at the first byte that
+// can't belong to it, which is then handled as usual
+static bool end_bare_token(chef_json_stream_t *s, char c) {
+    bool ok;
+    if (s->state == S_NUMBER) {
+        if (!is_number(s->tok, s->tok_len)) {
+            return fail(s, CHEF_JSON_ERR_SYNTAX);
+        }
+        value_done(s);
+        ok = emit(s, CHEF_JSON_NUMBER, s->depth);
+    } else {
+        ok = end_literal(s);
+    }
+    return ok && (c == '\0' || step(s, c));
+}
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool step_string(chef_json_stream_t *s, char c) {
+    switch (s->state) {
+        case S_STRING:
+            if (c == '"') {
+                if (s->is_key) {
+                    s->state = S_COLON;
+                    return emit(s, CHEF_JSON_KEY, s->depth);
+                }
+                value_done(s);
+                return emit(s, CHEF_JSON_STRING, s->depth);
+            }
+            if (c == '\\') {
+                s->state = S_ESCAPE;
+                return true;
+            }
+            if ((unsigned char)c < 0x20) {
+                return fail(s, CHEF_JSON_ERR_SYNTAX);
+            }
+            return push_byte(s, c);
+
+        case S_ESCAPE: {
+            static const char from[] = "\"\\/bfnrt";
+            static const char to[] = "\"\\/\b\f\n\r\t";
+            const char *p = strchr(from, c);
+            if (c == 'u') {
+                s->unicode = 0;
+                s->unicode_digits = 0;
+                s->state = S_UNICODE;
+                return true;
+            }
+            if (!p || c == '\0') {
+                return fail(s, CHEF_JSON_ERR_SYNTAX);
+            }
+            s->state = S_STRING;
+            return push_byte(s, to[p - from]);
+        }
+
+        default: {  // S_UNICODE
+            int v = hex_value(c);
+            if (v < 0) {
+                return fail(s, CHEF_JSON_ERR_SYNTAX);
+            }
+            s->unicode = (s->unicode << 4) | v;
+            if (++s->unicode_digits < 4) {
+                return true;
+            }
+            s->state = S_STRING;
+            uint32_t cp = s->unicode;
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                s->high_surrogate = cp;     // the low half follows as another \u
+                return true;
+            }
+            if (cp >= 0xDC00 && cp <= 0xDFFF && s->high_surrogate) {
+                cp = 0x10000 + ((s->high_surrogate - 0xD800) << 10) + (cp - 0xDC00);
+            }
+            s->high_surrogate = 0;
+            return push_utf8(s, cp);
+        }
+    }
+}
+
+static bool step(chef_json_stream_t *s, char c) {
+    switch (s->state) {
+        case S_STRING:
+        case S_ESCAPE:
+        case S_UNICODE:
+            return step_string(s, c);
+
+        case S_NUMBER:
+            if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+                return push_byte(s, c);
+            }
+            return end_bare_token(s, c);
+
+        case S_LITERAL:
+            if (c >= 'a' && c <= 'z') {
+                return push_byte(s, c);
+            }
+            return end_bare_token(s, c);
+
+        case S_ERROR:
+            return false;
+
+        default:
+            break;
+    }
+
+    if (is_space(c)) {
+        return true;
+    }
+
+    switch (s->state) {
+        case S_VALUE_OR_END:
+            if (c == ']') {
+                return close_container(s, false);
+            }
+            // fall through
+        case S_VALUE:
+            if (c == '{' || c == '[') {
+                return open_container(s, c == '{');
+            }
+            if (c == '"') {
+                s->is_key = false;
+                s->state = S_STRING;
+                return true;
+            }
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                s->state = S_NUMBER;
+                return push_byte(s, c);
+            }
+            if (c == 't' || c == 'f' || c == 'n') {
+                s->state = S_LITERAL;
+                return push_byte(s, c);
+            }
+            return fail(s, CHEF_JSON_ERR_SYNTAX);
+
+        case S_KEY_OR_END:
+            if (c == '}') {
+                return close_container(s, true);
+            }
+            // fall through
+        case S_KEY:
+            if (c == '"') {
+                s->is_key = true;
+                s->state = S_STRING;
+                return true;
+            }
+            return fail(s, CHEF_JSON_ERR_SYNTAX);
+
+        case S_COLON:
+            if (c == ':') {
+                s->state = S_VALUE;
+                return true;
+            }
+            return fail(s, CHEF_JSON_ERR_SYNTAX);
+
+        case S_COMMA_OR_END:
+            if (c == ',') {
+                s->state = top_is_object(s) ? S_KEY : S_VALUE;
+                return true;
+            }
+            if (c == (top_is_object(s) ? '}' : ']')) {
+                return close_container(s, top_is_object(s));
+            }
+            return fail(s, CHEF_JSON_ERR_SYNTAX);
+
+        default:  // S_DONE
+            return fail(s, CHEF_JSON_ERR_SYNTAX);
+    }
+}
+
+bool chef_json_stream_feed(chef_json_stream_t *s, const char *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (!step(s, data[i])) {
+            return false;
+        }
+        s->offset++;
+    }
+    return true;
+}
+
+bool chef_json_stream_finish(chef_json_stream_t *s) {
+    // a bare number or literal as the last token has not been closed yet
+    if ((s->state == S_NUMBER || s->state == S_LITERAL) && !end_bare_token(s, '\0')) {
+        return false;
+    }
+    if (s->state == S_ERROR) {
+        return false;
+    }
+    if (s->state != S_DONE) {
+        return fail(s, CHEF_JSON_ERR_TRUNCATED);
+    }
+    return true;
+}
+
+const char *chef_json_strerror(chef_json_error_t error) {
+    switch (error) {
+        case CHEF_JSON_OK:            return "ok";
+        case CHEF_JSON_ERR_SYNTAX:    return "syntax error";
+        case CHEF_JSON_ERR_TOKEN:     return "string too long";
+        case CHEF_JSON_ERR_DEPTH:     return "nested too deep";
+        case CHEF_JSON_ERR_ABORTED:   return "aborted";
+        case CHEF_JSON_ERR_TRUNCATED: return "truncated";
+    }
+    return "unknown";
+}
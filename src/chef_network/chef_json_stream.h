@@ -0,0 +1,71 @@
+#ifndef CHEF_JSON_STREAM_H
+#define CHEF_JSON_STREAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Incremental JSON tokenizer. Feed it the document in pieces of any size, as
+// they arrive from the network; it reports each token through a callback and
+// never holds more than one token. A string or number is limited to
+// CHEF_JSON_TOKEN_MAX - 1 bytes, so memory use does not depend on the size of
+// the document.
+
+#define CHEF_JSON_TOKEN_MAX 512
+#define CHEF_JSON_MAX_DEPTH 32
+
+typedef enum {
+    CHEF_JSON_OBJECT_START,
+    CHEF_JSON_OBJECT_END,
+    CHEF_JSON_ARRAY_START,
+    CHEF_JSON_ARRAY_END,
+    CHEF_JSON_KEY,          // text is the member name; its value follows
+    CHEF_JSON_STRING,       // text is unescaped UTF-8
+    CHEF_JSON_NUMBER,       // text as written, for strtod
+    CHEF_JSON_TRUE,
+    CHEF_JSON_FALSE,
+    CHEF_JSON_NULL,
+} chef_json_event_t;
+
+typedef enum {
+    CHEF_JSON_OK,
+    CHEF_JSON_ERR_SYNTAX,
+    CHEF_JSON_ERR_TOKEN,    // a string or number is longer than CHEF_JSON_TOKEN_MAX - 1
+    CHEF_JSON_ERR_DEPTH,
+    CHEF_JSON_ERR_ABORTED,  // the callback returned false
+    CHEF_JSON_ERR_TRUNCATED,
+} chef_json_error_t;
+
+// text is NUL-terminated and only valid during the call. depth is the nesting
+// level of the token: 1 for the root container's own start and end and its
+// direct members. Return false to stop parsing.
+typedef bool (*chef_json_cb_t)(chef_json_event_t event, const char *text, size_t len,
+                               int depth, void *ctx);
+
+typedef struct {
+    chef_json_cb_t cb;
+    void *ctx;
+    uint8_t state;
+    uint8_t depth;
+    uint32_t objects;           // bit n set: the container at depth n + 1 is an object
+    bool is_key;                // the string being read is a member name
+    char tok[CHEF_JSON_TOKEN_MAX];
+    size_t tok_len;
+    uint32_t unicode;           // \uXXXX being read
+    uint8_t unicode_digits;
+    uint32_t high_surrogate;
+    size_t offset;              // bytes consumed, for error messages
+    chef_json_error_t error;
+} chef_json_stream_t;
+
+void chef_json_stream_init(chef_json_stream_t *s, chef_json_cb_t cb, void *ctx);
+
+// Returns false once the document is known to be invalid; see s->error.
+bool chef_json_stream_feed(chef_json_stream_t *s, const char *data, size_t len);
+
+// Call after the last byte. True if exactly one complete document was read.
+bool chef_json_stream_finish(chef_json_stream_t *s);
+
+const char *chef_json_strerror(chef_json_error_t error);
+
+#endif
@@ -0,0 +1,144 @@
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "chef_recipe_stream.h"
+
+// Depths as reported by chef_json_stream: the root object is 1, the recipes
+// array 2 and each recipe object 3
+#define ROOT_DEPTH    1
+#define RECIPES_DEPTH 2
+#define RECIPE_DEPTH  3
+
+static const char *TAG = "RECIPE_STREAM";
+
+static void drop_partial(chef_recipe_stream_t *s) {
+    if (s->top > 0) {
+        cJSON_Delete(s->stack[0]);
+        s->top = 0;
+    }
+}
+
+// Attach a new node to the container being built
+static bool attach(chef_recipe_stream_t *s, cJSON *item) {
+    if (!item) {
+        ESP_LOGE(TAG, "Out of memory building recipe %d", s->count);
+        return false;
+    }
+    cJSON *parent = s->stack[s->top - 1];
+    if (cJSON_IsObject(parent)) {
+        cJSON_AddItemToObject(parent, s->key, item);
+    } else {
+        cJSON_AddItemToArray(parent, item);
+    }
+    return true;
+}
+
+static bool open_node(chef_recipe_stream_t *s, cJSON *node) {
+    if (!node) {
+        ESP_LOGE(TAG, "Out of memory building recipe %d", s->count);
+        return false;
+    }
+    if (s->top == CHEF_RECIPE_MAX_DEPTH) {
+        ESP_LOGE(TAG, "Recipe %d is nested too deep", s->count);
+        cJSON_Delete(node);
+        return false;
+    }
+    if (s->top > 0 && !attach(s, node)) {
+        return false;
+    }
+    s->stack[s->top++] = node;
+    return true;
+}
+
+static bool close_node(chef_recipe_stream_t *s) {
+    if (--s->top > 0) {
+        return true;
+    }
+    // the recipe's closing brace: hand it over
+    s->count++;
+    return s->cb(s->stack[0], s->ctx);
+}
+
+static bool on_token(chef_json_event_t event, const char *text, size_t len, int depth, void *ctx) {
+    chef_recipe_stream_t *s = ctx;
+    (void)len;  // text is NUL-terminated, cJSON takes it as is
+
+    if (s->skip_depth) {
+        if ((event == CHEF_JSON_OBJECT_END || event == CHEF_JSON_ARRAY_END) && depth == s->skip_depth) {
+            s->skip_depth = 0;
+        }
+        return true;
+    }
+
+    if (s->top == 0) {
+        // outside any recipe: look for the root "recipes" array and the start of each element
+        if (event == CHEF_JSON_KEY && depth == ROOT_DEPTH) {
+            s->recipes_next = strcmp(text, "recipes") == 0;
+        } else if (event == CHEF_JSON_ARRAY_START && depth == RECIPES_DEPTH && s->recipes_next) {
+            s->in_recipes = true;
+        } else if (event == CHEF_JSON_ARRAY_END && depth == RECIPES_DEPTH && s->in_recipes) {
+            s->in_recipes = false;
+        } else if (s->in_recipes && event == CHEF_JSON_OBJECT_START && depth == RECIPE_DEPTH) {
+            return open_node(s, cJSON_CreateObject());
+        } else if (s->in_recipes && depth <= RECIPE_DEPTH &&
+                   event != CHEF_JSON_OBJECT_END && event != CHEF_JSON_ARRAY_END) {
+            ESP_LOGW(TAG, "Skipping a recipe that is not an object");
+            s->skipped++;
+            if (event == CHEF_JSON_ARRAY_START) {
+                s->skip_depth = depth;
+            }
+        }
+        return true;
+    }
+
+    switch (event) {
+        case CHEF_JSON_KEY:
+            strncpy(s->key, text, sizeof(s->key) - 1);
+            s->key[sizeof(s->key) - 1] = '\0';
+            return true;
+        case CHEF_JSON_OBJECT_START:
+            return open_node(s, cJSON_CreateObject());
+        case CHEF_JSON_ARRAY_START:
+            return open_node(s, cJSON_CreateArray());
+        case CHEF_JSON_OBJECT_END:
+        case CHEF_JSON_ARRAY_END:
+            return close_node(s);
+        case CHEF_JSON_STRING:
+            return attach(s, cJSON_CreateString(text));
+        case CHEF_JSON_NUMBER:
+            return attach(s, cJSON_CreateNumber(strtod(text, NULL)));
+        case CHEF_JSON_TRUE:
+            return attach(s, cJSON_CreateTrue());
+        case CHEF_JSON_FALSE:
+            return attach(s, cJSON_CreateFalse());
+        case CHEF_JSON_NULL:
+            return attach(s, cJSON_CreateNull());
+    }
+    return true;
+}
+
+void chef_recipe_stream_init(chef_recipe_stream_t *s, chef_recipe_cb_t cb, void *ctx) {
+    memset(s, 0, sizeof(*s));
+    s->cb = cb;
+    s->ctx = ctx;
+    chef_json_stream_init(&s->json, on_token, s);
+}
+
+bool chef_recipe_stream_feed(chef_recipe_stream_t *s, const char *data, size_t len) {
+    if (chef_json_stream_feed(&s->json, data, len)) {
+        return true;
+    }
+    ESP_LOGE(TAG, "Catalog rejected at byte %u: %s", (unsigned)s->json.offset,
+             chef_json_strerror(s->json.error));
+    drop_partial(s);
+    return false;
+}
+
+bool chef_recipe_stream_finish(chef_recipe_stream_t *s) {
+    bool ok = chef_json_stream_finish(&s->json);
+    if (!ok) {
+        ESP_LOGE(TAG, "Catalog incomplete: %s", chef_json_strerror(s->json.error));
+    }
+    drop_partial(s);
+    return ok;
+}
@@ -0,0 +1,44 @@
+#ifndef CHEF_RECIPE_STREAM_H
+#define CHEF_RECIPE_STREAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cJSON.h"
+#include "chef_json_stream.h"
+
+// Builds recipes from a catalog document ({"recipes": [ {...}, ... ]}) as it
+// streams in. Each element of the "recipes" array becomes a cJSON object that
+// is handed to the callback as soon as its closing brace arrives; everything
+// outside that array is skipped. Only the recipe being built is held, so peak
+// memory is set by the largest recipe, not by the catalog.
+
+#define CHEF_RECIPE_KEY_MAX   32   // longer member names are truncated
+#define CHEF_RECIPE_MAX_DEPTH 8    // nesting inside one recipe
+
+// Takes ownership of recipe. Return false to stop the download.
+typedef bool (*chef_recipe_cb_t)(cJSON *recipe, void *ctx);
+
+typedef struct {
+    chef_json_stream_t json;
+    chef_recipe_cb_t cb;
+    void *ctx;
+    bool recipes_next;          // the root member being read is "recipes"
+    bool in_recipes;            // inside the root "recipes" array
+    int skip_depth;             // skipping an element that is not an object, until this depth closes
+    char key[CHEF_RECIPE_KEY_MAX];  // member name waiting for its value
+    cJSON *stack[CHEF_RECIPE_MAX_DEPTH];  // containers of the recipe being built
+    int top;                    // entries in stack
+    int count;                  // recipes delivered
+    int skipped;                // array elements that were not objects
+} chef_recipe_stream_t;
+
+void chef_recipe_stream_init(chef_recipe_stream_t *s, chef_recipe_cb_t cb, void *ctx);
+
+// Feed the next piece of the body. Returns false on a malformed document.
+bool chef_recipe_stream_feed(chef_recipe_stream_t *s, const char *data, size_t len);
+
+// Call after the last piece; false if the document was incomplete or invalid.
+// Frees a partly built recipe either way.
+bool chef_recipe_stream_finish(chef_recipe_stream_t *s);
+
+#endif
@@ -0,0 +1,92 @@
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "chef_catalog.h"
+
+static const char *TAG = "CATALOG";
+
+// Open addressing with linear probing, at most half full, so a miss ends
+// within a slot or two of its home on average
+typedef struct {
+    chef_recipe_id_t id;        // CHEF_RECIPE_NO_ID: empty
+    uint32_t recipe;            // index in the pack's recipe table
+} slot_t;
+
+static const chef_pack_t *pack = NULL;
+static slot_t *slots = NULL;
+static uint32_t mask;           // slot count - 1, a power of two
+
+bool chef_catalog_load(const chef_pack_t *new_pack) {
+    free(slots);
+    slots = NULL;
+    pack = NULL;
+    if (!new_pack) {
+        return true;
+    }
+
+    uint32_t count = 8;
+    while (count < new_pack->recipe_count * 2) {
+        count *= 2;
+    }
+    slots = calloc(count, sizeof(slot_t));
+    if (!slots) {
+        ESP_LOGE(TAG, "No memory for %" PRIu32 " index slots", count);
+        return false;
+    }
+    pack = new_pack;
+    mask = count - 1;
+
+    for (uint32_t i = 0; i < pack->recipe_count; i++) {
+        chef_recipe_id_t id = chef_pack_name_id(chef_pack_str(pack, chef_pack_recipe(pack, i)->name));
+        uint32_t s = id & mask;
+        while (slots[s].id != CHEF_RECIPE_NO_ID) {
+            if (slots[s].id == id) {
+                // chef_packc rejects this; keep the first so lookups stay predictable
+                ESP_LOGW(TAG, "Recipe %" PRIu32 " has the ID of recipe %" PRIu32 ", skipping it",
+                         i, slots[s].recipe);
+                break;
+            }
+            s = (s + 1) & mask;
+        }
+        if (slots[s].id == CHEF_RECIPE_NO_ID) {
+            slots[s].id = id;
+            slots[s].recipe = i;
+        }
+    }
+    ESP_LOGI(TAG, "Indexed %" PRIu32 " recipes in %" PRIu32 " slots", pack->recipe_count, count);
+    return true;
+}
+
+const chef_pack_t *chef_catalog_pack(void) {
+    return pack;
+}
+
+uint32_t chef_catalog_count(void) {
+    return pack ? pack->recipe_count : 0;
+}
+
+const chef_pack_recipe_t *chef_catalog_at(uint32_t i) {
+    return i < chef_catalog_count() ? chef_pack_recipe(pack, i) : NULL;
+}
+
+const chef_pack_recipe_t *chef_catalog_get(chef_recipe_id_t id) {
+    if (!pack || id == CHEF_RECIPE_NO_ID) {
+        return NULL;
+    }
+    for (uint32_t s = id & mask; slots[s].id != CHEF_RECIPE_NO_ID; s = (s + 1) & mask) {
+        if (slots[s].id == id) {
+            return chef_pack_recipe(pack, slots[s].recipe);
+        }
+    }
+    return NULL;
+}
+
+const chef_pack_recipe_t *chef_catalog_find(const char *name) {
+    if (!name) {
+        return NULL;
+    }
+    const chef_pack_recipe_t *recipe = chef_catalog_get(chef_pack_name_id(name));
+    // the ID only narrows it down to one candidate; the name confirms it
+    return recipe && strcmp(chef_catalog_name(recipe), name) == 0 ? recipe : NULL;
+}
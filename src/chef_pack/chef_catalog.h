@@ -0,0 +1,38 @@
+#ifndef CHEF_CATALOG_H
+#define CHEF_CATALOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "chef_pack.h"
+
+// The recipes of the current pack, with a hash index built once when the pack
+// is loaded, so finding a recipe by name or ID costs the same however large
+// the catalog is. Load it before the screens are built; lookups are not safe
+// against a concurrent load.
+
+typedef uint32_t chef_recipe_id_t;     // see chef_pack_name_id
+#define CHEF_RECIPE_NO_ID 0
+
+// Index pack, replacing the previous one; NULL empties the catalog. Returns
+// false if the index could not be allocated, which also empties it.
+bool chef_catalog_load(const chef_pack_t *pack);
+
+const chef_pack_t *chef_catalog_pack(void);
+
+// In pack order, for lists
+uint32_t chef_catalog_count(void);
+const chef_pack_recipe_t *chef_catalog_at(uint32_t i);
+
+// NULL if there is no such recipe
+const chef_pack_recipe_t *chef_catalog_find(const char *name);
+const chef_pack_recipe_t *chef_catalog_get(chef_recipe_id_t id);
+
+static inline const char *chef_catalog_name(const chef_pack_recipe_t *recipe) {
+    return chef_pack_str(chef_catalog_pack(), recipe->name);
+}
+
+static inline chef_recipe_id_t chef_catalog_id(const chef_pack_recipe_t *recipe) {
+    return chef_pack_name_id(chef_catalog_name(recipe));
+}
+
+#endif
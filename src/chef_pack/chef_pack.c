@@ -0,0 +1,79 @@
+#include <string.h>
+#include "chef_pack.h"
+
+// Nibble-at-a-time CRC-32 (IEEE): a 64-byte table instead of 1 KB
+uint32_t chef_pack_crc32(uint32_t crc, const void *data, size_t len) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    const uint8_t *p = data;
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+        crc = (crc >> 4) ^ table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+// A record array of count entries at off lies inside the image, aligned
+static bool range_ok(const chef_pack_t *pack, uint32_t off, uint32_t count, size_t entry) {
+    return off >= pack->header_size && off % 4 == 0 && off + (uint64_t)count * entry <= pack->size;
+}
+
+// A string starts inside the image and ends there too, within CHEF_PACK_STR_MAX
+static bool str_ok(const chef_pack_t *pack, uint32_t off) {
+    if (off < pack->header_size || off >= pack->size) {
+        return false;
+    }
+    size_t room = pack->size - off;
+    return memchr(chef_pack_str(pack, off), '\0', room < CHEF_PACK_STR_MAX ? room : CHEF_PACK_STR_MAX) != NULL;
+}
+
+const chef_pack_t *chef_pack_open(const void *image, size_t size) {
+    const chef_pack_t *pack = image;
+    if (size < sizeof(chef_pack_t) || pack->magic != CHEF_PACK_MAGIC ||
+        pack->version != CHEF_PACK_VERSION || pack->header_size != sizeof(chef_pack_t)) {
+        return NULL;
+    }
+    if (pack->size < pack->header_size || pack->size > size ||
+        !range_ok(pack, pack->recipes_off, pack->recipe_count, sizeof(chef_pack_recipe_t))) {
+        return NULL;
+    }
+    const uint8_t *body = (const uint8_t *)image + pack->header_size;
+    if (chef_pack_crc32(0, body, pack->size - pack->header_size) != pack->crc) {
+        return NULL;
+    }
+
+    // The CRC only shows the body is the one the header was written for, not
+    // who wrote it: a pack arrives over the network, so every offset the
+    // screens will follow is checked here, once, instead of on each read
+    uint32_t ingredient_count = 0, step_count = 0;
+    for (uint32_t i = 0; i < pack->recipe_count; i++) {
+        const chef_pack_recipe_t *recipe = chef_pack_recipe(pack, i);
+        if (!str_ok(pack, recipe->name) ||
+            !range_ok(pack, recipe->ingredients_off, recipe->ingredient_count, sizeof(chef_pack_ingredient_t)) ||
+            !range_ok(pack, recipe->steps_off, recipe->step_count, sizeof(chef_pack_step_t))) {
+            return NULL;
+        }
+        const chef_pack_ingredient_t *ingredients = chef_pack_ingredients(pack, recipe);
+        for (uint16_t j = 0; j < recipe->ingredient_count; j++) {
+            if (!str_ok(pack, ingredients[j].item) || !str_ok(pack, ingredients[j].quantity)) {
+                return NULL;
+            }
+        }
+        const chef_pack_step_t *steps = chef_pack_steps(pack, recipe);
+        for (uint16_t j = 0; j < recipe->step_count; j++) {
+            if (!str_ok(pack, steps[j].text)) {
+                return NULL;
+            }
+        }
+        ingredient_count += recipe->ingredient_count;
+        step_count += recipe->step_count;
+    }
+    if (ingredient_count != pack->ingredient_count || step_count != pack->step_count) {
+        return NULL;
+    }
+    return pack;
+}
@@ -0,0 +1,99 @@
+#ifndef CHEF_PACK_H
+#define CHEF_PACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Recipe pack: the catalog as one flat, read-only image. Readers use it in
+// place, straight from memory-mapped flash: lookups are pointer arithmetic,
+// nothing is parsed or copied to the heap.
+//
+// Layout (little endian, every offset counts from the start of the image):
+//
+//   chef_pack_t                    header
+//   chef_pack_recipe_t[]           recipe table, recipe_count used entries
+//   per recipe, anywhere after the table:
+//     chef_pack_ingredient_t[]     its ingredients, contiguous
+//     chef_pack_step_t[]           its steps, contiguous
+//     strings                      NUL-terminated UTF-8
+//
+// Records are 4-byte aligned. The header is written last and covers the rest
+// with a CRC, so a pack cut short by a reset is never mistaken for a good one.
+// Packs are built on the host, see chef_tools/chef_pack_writer.h; the device
+// only opens them.
+
+#define CHEF_PACK_MAGIC   0x4B504843u  // "CHPK"
+#define CHEF_PACK_VERSION 1
+
+#define CHEF_PACK_MAX_SIZE    0x78000  // one slot: half the spiffs partition in 3MB_app.csv
+#define CHEF_PACK_MAX_RECIPES 2048
+#define CHEF_PACK_STR_MAX     1024     // longest string, terminator included; above CHEF_JSON_TOKEN_MAX
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;       // sizeof(chef_pack_t) when written
+    uint32_t generation;        // bumped by every sync, the newest valid pack wins
+    uint32_t size;              // bytes in the image, header included
+    uint32_t crc;               // CRC-32 of the bytes after the header
+    uint32_t recipe_count;
+    uint32_t ingredient_count;  // totals over all recipes, for statistics
+    uint32_t step_count;
+    uint32_t recipes_off;
+} chef_pack_t;
+
+typedef struct {
+    uint32_t name;
+    uint32_t ingredients_off;
+    uint32_t steps_off;
+    uint16_t ingredient_count;
+    uint16_t step_count;
+} chef_pack_recipe_t;
+
+typedef struct {
+    uint32_t item;
+    uint32_t quantity;
+} chef_pack_ingredient_t;
+
+typedef struct {
+    uint32_t text;
+} chef_pack_step_t;
+
+// Returns the pack at image, or NULL unless it is a complete pack of this
+// version that fits in size bytes and every offset in it stays inside the
+// image. The accessors below do no checks of their own.
+const chef_pack_t *chef_pack_open(const void *image, size_t size);
+
+static inline const char *chef_pack_str(const chef_pack_t *pack, uint32_t off) {
+    return (const char *)pack + off;
+}
+
+static inline const chef_pack_recipe_t *chef_pack_recipe(const chef_pack_t *pack, uint32_t i) {
+    return (const chef_pack_recipe_t *)((const uint8_t *)pack + pack->recipes_off) + i;
+}
+
+static inline const chef_pack_ingredient_t *chef_pack_ingredients(const chef_pack_t *pack,
+                                                                  const chef_pack_recipe_t *recipe) {
+    return (const chef_pack_ingredient_t *)((const uint8_t *)pack + recipe->ingredients_off);
+}
+
+static inline const chef_pack_step_t *chef_pack_steps(const chef_pack_t *pack,
+                                                      const chef_pack_recipe_t *recipe) {
+    return (const chef_pack_step_t *)((const uint8_t *)pack + recipe->steps_off);
+}
+
+// A recipe's stable ID: FNV-1a of its name, so it survives a new pack for as
+// long as the name does. chef_packc rejects catalogs where two names share one.
+// Never 0.
+static inline uint32_t chef_pack_name_id(const char *name) {
+    uint32_t h = 2166136261u;
+    while (*name) {
+        h = (h ^ (uint8_t)*name++) * 16777619u;
+    }
+    return h ? h : 1;
+}
+
+uint32_t chef_pack_crc32(uint32_t crc, const void *data, size_t len);
+
+#endif
@@ -0,0 +1,138 @@
+#include <inttypes.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "chef_pack_store.h"
+
+static const char *TAG = "PACK_STORE";
+
+static const esp_partition_t *partition = NULL;
+static const uint8_t *mapped = NULL;
+static esp_partition_mmap_handle_t map_handle;
+static uint32_t slot_size;
+static int active_slot = -1;
+static const chef_pack_t *active = NULL;
+
+static uint32_t spare_base;         // partition offset of the slot being written
+static uint32_t spare_erased;       // bytes of it erased so far
+static chef_pack_t header;          // of the pack being received
+static uint32_t received;
+
+static const chef_pack_t *open_slot(int slot) {
+    return chef_pack_open(mapped + slot * slot_size, slot_size);
+}
+
+esp_err_t chef_pack_store_init(void) {
+    if (mapped) {
+        return ESP_OK;
+    }
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS,
+                                         CHEF_PACK_PARTITION);
+    if (!partition) {
+        ESP_LOGE(TAG, "No %s partition", CHEF_PACK_PARTITION);
+        return ESP_ERR_NOT_FOUND;
+    }
+    // whole sectors per slot, so erasing one never touches the other
+    slot_size = (partition->size / 2) & ~(partition->erase_size - 1);
+
+    const void *ptr;
+    esp_err_t err = esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA,
+                                       &ptr, &map_handle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Cannot map %s: %s", CHEF_PACK_PARTITION, esp_err_to_name(err));
+        return err;
+    }
+    mapped = ptr;
+
+    for (int slot = 0; slot < 2; slot++) {
+        const chef_pack_t *pack = open_slot(slot);
+        if (pack && (!active || pack->generation - active->generation < UINT32_MAX / 2)) {
+            active = pack;
+            active_slot = slot;
+        }
+    }
+    if (active) {
+        ESP_LOGI(TAG, "Pack %" PRIu32 " in slot %d: %" PRIu32 " recipes, %" PRIu32 " bytes",
+                 active->generation, active_slot, active->recipe_count, active->size);
+    } else {
+        ESP_LOGI(TAG, "No recipe pack stored");
+    }
+    return ESP_OK;
+}
+
+const chef_pack_t *chef_pack_store_get(void) {
+    return active;
+}
+
+// Sectors are erased just ahead of the first write that reaches them, so a
+// small catalog does not pay for erasing the whole slot
+static bool spare_write(uint32_t offset, const void *data, size_t len) {
+    uint32_t end = offset + len;
+    if (end > slot_size) {
+        return false;
+    }
+    if (end > spare_erased) {
+        uint32_t erase_end = (end + partition->erase_size - 1) & ~(partition->erase_size - 1);
+        if (esp_partition_erase_range(partition, spare_base + spare_erased, erase_end - spare_erased) != ESP_OK) {
+            return false;
+        }
+        spare_erased = erase_end;
+    }
+    return esp_partition_write(partition, spare_base + offset, data, len) == ESP_OK;
+}
+
+esp_err_t chef_pack_store_receive_begin(void) {
+    esp_err_t err = chef_pack_store_init();
+    if (err != ESP_OK) {
+        return err;
+    }
+    spare_base = (active_slot == 0 ? 1 : 0) * slot_size;
+    spare_erased = 0;
+    received = 0;
+    return ESP_OK;
+}
+
+// The header is held back and written last, once the rest is in flash
+esp_err_t chef_pack_store_receive(const void *data, size_t len) {
+    const uint8_t *p = data;
+    if (received < sizeof(header)) {
+        size_t n = sizeof(header) - received < len ? sizeof(header) - received : len;
+        memcpy((uint8_t *)&header + received, p, n);
+        received += n;
+        p += n;
+        len -= n;
+    }
+    if (len == 0) {
+        return ESP_OK;
+    }
+    if (!spare_write(received, p, len)) {
+        ESP_LOGE(TAG, "Cannot write %u bytes at %" PRIu32, (unsigned)len, received);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    received += len;
+    return ESP_OK;
+}
+
+esp_err_t chef_pack_store_receive_commit(void) {
+    if (received < sizeof(header) || header.magic != CHEF_PACK_MAGIC || header.size != received) {
+        ESP_LOGE(TAG, "Received %" PRIu32 " bytes, not a recipe pack", received);
+        return ESP_ERR_INVALID_ARG;
+    }
+    // packs are built without knowing what the device holds; order them here
+    header.generation = active ? active->generation + 1 : 1;
+    if (!spare_write(0, &header, sizeof(header))) {
+        return ESP_FAIL;
+    }
+
+    int slot = spare_base ? 1 : 0;
+    const chef_pack_t *pack = open_slot(slot);
+    if (!pack) {
+        ESP_LOGE(TAG, "Pack in slot %d does not verify", slot);
+        return ESP_ERR_INVALID_CRC;
+    }
+    active = pack;
+    active_slot = slot;
+    ESP_LOGI(TAG, "Pack %" PRIu32 " in slot %d: %" PRIu32 " recipes, %" PRIu32 " bytes",
+             pack->generation, slot, pack->recipe_count, pack->size);
+    return ESP_OK;
+}
@@ -0,0 +1,28 @@
+#ifndef CHEF_PACK_STORE_H
+#define CHEF_PACK_STORE_H
+
+#include "esp_err.h"
+#include "chef_pack.h"
+
+// The recipe pack in flash. The spiffs partition is split into two slots: a
+// sync writes the slot not in use and the newest valid pack is served, so a
+// failed or interrupted sync leaves the previous catalog in place. The whole
+// partition is memory-mapped once; readers get pointers into flash.
+
+#define CHEF_PACK_PARTITION "spiffs"
+
+// Map the partition and pick the newest valid pack. Safe to call again.
+esp_err_t chef_pack_store_init(void);
+
+// NULL until a sync has succeeded once. The pointer, and every string reached
+// through it, stays valid until the next sync after the one that replaces it.
+const chef_pack_t *chef_pack_store_get(void);
+
+// Receiving a pack built by chef_packc: begin, hand over the file in pieces
+// as they arrive, then commit. The pack is served from the commit on, if it
+// verifies; otherwise the previous one stays.
+esp_err_t chef_pack_store_receive_begin(void);
+esp_err_t chef_pack_store_receive(const void *data, size_t len);
+esp_err_t chef_pack_store_receive_commit(void);
+
+#endif
@@ -0,0 +1,35 @@
+#include "chef_scale_service.h"
+
+int32_t chef_scale_tenths(int32_t weight_mg) {
+    // widen first: rounding INT32_MIN away from zero would overflow
+    int64_t mg = weight_mg;
+    return (int32_t)(mg < 0 ? (mg - 50) / 100 : (mg + 50) / 100);
+}
+
+size_t chef_scale_format(int32_t weight_mg, char *buf) {
+    int32_t rounded = chef_scale_tenths(weight_mg);
+    // a reading that rounds to zero is 0, so there is no "-0.0"
+    bool negative = rounded < 0;
+    uint32_t tenths = negative ? -(uint32_t)rounded : (uint32_t)rounded;
+
+    // build right to left: the decimal, the point, then at least one integer digit
+    char digits[CHEF_SCALE_TEXT_MAX];
+    size_t n = 0;
+    digits[n++] = '0' + tenths % 10;
+    digits[n++] = '.';
+    tenths /= 10;
+    do {
+        digits[n++] = '0' + tenths % 10;
+        tenths /= 10;
+    } while (tenths);
+
+    size_t len = 0;
+    if (negative) {
+        buf[len++] = '-';
+    }
+    while (n) {
+        buf[len++] = digits[--n];
+    }
+    buf[len] = '\0';
+    return len;
+}
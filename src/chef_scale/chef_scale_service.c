@@ -0,0 +1,218 @@
+#include <string.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "chef_scale_service.h"
+#include "../chef_hx711/HX711.h"
+#include "../chef_hx711/HX711_calib.h"
+
+#define GPIO_DATA   GPIO_NUM_27
+#define GPIO_SCLK   GPIO_NUM_12
+
+#define SCALE_TASK_STACK    4096
+#define SCALE_TASK_PRIORITY 1
+#define SCALE_TASK_CORE     0
+
+#define MEDIAN_SAMPLES   5      // rejects single-sample spikes
+#define EMA_ALPHA        HX711_ALPHA(0.3f)
+#define STABLE_BAND_MG   1000   // the reading may wander this far and still count as settled
+#define STABLE_SAMPLES   8      // 0.8 s at 10 SPS
+#define SAMPLE_WAIT_MS   200    // acquisition wakes us per sample; this only bounds a stall
+#define ZERO_SAMPLES     16     // settled samples averaged into the refined zero
+#define ZERO_TRACK_BAND_MG  500 // drift followed automatically while the platform is empty
+#define ZERO_TRACK_STEP_MG  1   // per sample: at most 80 mg/s at 80 SPS, far slower than any pour
+#define ZERO_REFINE_BAND_MG 50  // only readings this close to the tracked zero are averaged into it
+#define ZERO_SAVE_MIN_MG    200 // tracked drift worth writing back to NVS
+#define ZERO_SAVE_INTERVAL_US (10 * 60 * 1000000LL)  // at most one write per 10 minutes
+
+static const char *TAG = "SCALE";
+
+typedef struct {
+    chef_scale_cb_t cb;
+    void *ctx;
+} subscriber_t;
+
+static subscriber_t subscribers[CHEF_SCALE_MAX_SUBSCRIBERS];
+static int subscriber_count = 0;
+static SemaphoreHandle_t subscribers_lock;  // held while callbacks run
+static TaskHandle_t scale_task = NULL;
+
+// Use the stored calibration if there is one, so the first reading needs no tare. Without
+// one, tare (about 2 s) and store that zero with the driver's default scale.
+static void load_calibration(HX711_dev_t *dev) {
+    HX711_calib_t cal;
+    esp_err_t err = HX711_calib_load(&cal);
+    if (err == ESP_OK) {
+        HX711_calib_apply(dev, &cal);
+        ESP_LOGI(TAG, "Stored calibration: offset %" PRId32 ", gain %" PRId32, cal.offset[0], cal.gain_q[0]);
+        return;
+    }
+
+    ESP_LOGI(TAG, "No stored calibration (%s), taring", esp_err_to_name(err));
+    HX711_tare();
+    HX711_calib_capture(dev, &cal);
+    HX711_calib_save(&cal);
+}
+
+static bool has_subscribers(void) {
+    xSemaphoreTake(subscribers_lock, portMAX_DELAY);
+    bool any = subscriber_count > 0;
+    xSemaphoreGive(subscribers_lock);
+    return any;
+}
+
+static void publish(const chef_scale_reading_t *reading) {
+    xSemaphoreTake(subscribers_lock, portMAX_DELAY);
+    for (int i = 0; i < CHEF_SCALE_MAX_SUBSCRIBERS; i++) {
+        if (subscribers[i].cb) {
+            subscribers[i].cb(reading, subscribers[i].ctx);
+        }
+    }
+    xSemaphoreGive(subscribers_lock);
+}
+
+static void scale_service_task(void *arg) {
+    HX711_init_backend(GPIO_DATA, GPIO_SCLK, eGAIN_128, eBACKEND_SPI);
+    HX711_dev_t *dev = HX711_default();
+    load_calibration(dev);
+    uint8_t channels = HX711_dev_channels(dev);
+
+    HX711_filter_t filter;
+    HX711_filter_init(&filter, MEDIAN_SAMPLES, EMA_ALPHA, STABLE_BAND_MG, STABLE_SAMPLES);
+    HX711_filter_set_zero_tracking(&filter, ZERO_TRACK_BAND_MG, ZERO_TRACK_STEP_MG);
+
+    // The stored zero is re-measured in the background once zero tracking has moved it
+    // enough to be worth keeping across a restart, and at most once per interval. Nothing
+    // is re-zeroed on wake: whatever is on the platform then would be tared away
+    int64_t zero_saved_us = esp_timer_get_time();
+    uint8_t zero_count = 0;
+    int64_t zero_sum[HX711_MAX_CHANNELS] = { 0 };
+    int64_t zero_moved_mg = 0;
+
+    while (1) {
+        while (!has_subscribers()) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+
+        ESP_LOGI(TAG, "Starting");
+        HX711_power_up();
+        // Conversions arrive by interrupt; each one goes through the filter as it is stored
+        HX711_set_reader(xTaskGetCurrentTaskHandle());
+        HX711_start_acquisition();
+        HX711_filter_reset(&filter);
+        uint32_t cursor = HX711_sample_cursor();
+        zero_count = 0;
+
+        while (has_subscribers()) {
+            HX711_sample_t sample;
+            while (HX711_next_sample(&cursor, &sample)) {
+                HX711_filter_out_t out = HX711_filter_push(&filter, sample.weight_mg);
+                chef_scale_reading_t reading = {
+                    .weight_mg = out.value,
+                    .stable = out.stable,
+                    .event = out.event,
+                    .time_us = sample.time_us,
+                };
+                publish(&reading);
+
+                int32_t drift = filter.zero.zero;
+                bool small = drift > -ZERO_SAVE_MIN_MG && drift < ZERO_SAVE_MIN_MG;
+                if (small || sample.time_us - zero_saved_us < ZERO_SAVE_INTERVAL_US) {
+                    continue;
+                }
+                if (!out.stable || out.value > ZERO_REFINE_BAND_MG || out.value < -ZERO_REFINE_BAND_MG) {
+                    zero_count = 0;
+                    continue;
+                }
+                if (zero_count == 0) {
+                    memset(zero_sum, 0, sizeof(zero_sum));
+                    zero_moved_mg = 0;
+                }
+                for (uint8_t c = 0; c < channels; c++) {
+                    zero_sum[c] += sample.raw[c];
+                }
+                // sample.weight_mg counts from the stored zero, so this is how far it moved
+                zero_moved_mg += sample.weight_mg;
+                if (++zero_count < ZERO_SAMPLES) {
+                    continue;
+                }
+                zero_count = 0;
+                zero_saved_us = sample.time_us;
+                zero_moved_mg /= ZERO_SAMPLES;
+                if (zero_moved_mg > -ZERO_SAVE_MIN_MG && zero_moved_mg < ZERO_SAVE_MIN_MG) {
+                    // tracking overshot on noise; try again next interval
+                    continue;
+                }
+                int32_t offset[HX711_MAX_CHANNELS];
+                for (uint8_t c = 0; c < channels; c++) {
+                    offset[c] = zero_sum[c] / ZERO_SAMPLES;
+                }
+                HX711_calib_save_zero(dev, offset);
+                // the new offsets already include whatever was tracked
+                HX711_filter_reset(&filter);
+                HX711_zero_track_reset(&filter.zero);
+                ESP_LOGI(TAG, "Zero refined to %" PRId32 ", moved %" PRId64 " mg", offset[0], zero_moved_mg);
+            }
+            // woken by the next sample, so readings go out at the sensor rate; an unsubscribe
+            // wakes us too, so the chip is powered down promptly
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SAMPLE_WAIT_MS));
+        }
+
+        ESP_LOGI(TAG, "No subscribers, powering down");
+        HX711_set_reader(NULL);
+        HX711_power_down();
+    }
+}
+
+chef_scale_sub_t chef_scale_subscribe(chef_scale_cb_t cb, void *ctx) {
+    if (!subscribers_lock) {
+        subscribers_lock = xSemaphoreCreateMutex();
+    }
+
+    chef_scale_sub_t sub = CHEF_SCALE_NO_SUB;
+    xSemaphoreTake(subscribers_lock, portMAX_DELAY);
+    for (int i = 0; i < CHEF_SCALE_MAX_SUBSCRIBERS; i++) {
+        if (!subscribers[i].cb) {
+            subscribers[i].cb = cb;
+            subscribers[i].ctx = ctx;
+            subscriber_count++;
+            sub = i;
+            break;
+        }
+    }
+    xSemaphoreGive(subscribers_lock);
+
+    if (sub == CHEF_SCALE_NO_SUB) {
+        ESP_LOGE(TAG, "No free subscriber slot");
+        return sub;
+    }
+
+    if (!scale_task) {
+        xTaskCreatePinnedToCore(scale_service_task, "scale_service", SCALE_TASK_STACK, NULL,
+                                SCALE_TASK_PRIORITY, &scale_task, SCALE_TASK_CORE);
+    } else {
+        xTaskNotifyGive(scale_task);
+    }
+    return sub;
+}
+
+void chef_scale_unsubscribe(chef_scale_sub_t sub) {
+    if (sub < 0 || sub >= CHEF_SCALE_MAX_SUBSCRIBERS) {
+        return;
+    }
+
+    xSemaphoreTake(subscribers_lock, portMAX_DELAY);
+    if (subscribers[sub].cb) {
+        subscribers[sub].cb = NULL;
+        subscribers[sub].ctx = NULL;
+        subscriber_count--;
+    }
+    xSemaphoreGive(subscribers_lock);
+
+    if (scale_task) {
+        xTaskNotifyGive(scale_task);
+    }
+}
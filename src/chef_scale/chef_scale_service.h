@@ -0,0 +1,45 @@
+#ifndef CHEF_SCALE_SERVICE_H
+#define CHEF_SCALE_SERVICE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../chef_hx711/HX711_filter.h"
+
+// One service owns the HX711. It runs only while someone is subscribed: the
+// first subscriber powers the chip up and starts acquisition, the last
+// unsubscribe stops it and powers the chip down. Readings are filtered once
+// and handed to every subscriber from the service task.
+
+#define CHEF_SCALE_MAX_SUBSCRIBERS 4
+
+typedef struct {
+    int32_t weight_mg;          // filtered, calibrated weight in milli-units
+    bool stable;
+    HX711_STABLE_EVENT event;   // set on the reading where stability changed
+    int64_t time_us;            // esp_timer time of the conversion
+} chef_scale_reading_t;
+
+// Runs on the service task. Post widget updates through chef_ui_queue.h.
+typedef void (*chef_scale_cb_t)(const chef_scale_reading_t *reading, void *ctx);
+
+typedef int chef_scale_sub_t;
+#define CHEF_SCALE_NO_SUB (-1)
+
+// Returns CHEF_SCALE_NO_SUB if all slots are taken.
+chef_scale_sub_t chef_scale_subscribe(chef_scale_cb_t cb, void *ctx);
+
+// Once this returns the callback is not running and will not be called again.
+void chef_scale_unsubscribe(chef_scale_sub_t sub);
+
+#define CHEF_SCALE_TEXT_MAX 12  // "-2147483.6" and the terminator
+
+// The value chef_scale_format shows, in tenths of a unit. Compare these to
+// tell whether a reading changes the display.
+int32_t chef_scale_tenths(int32_t weight_mg);
+
+// Format a weight with one decimal, rounded half away from zero ("-12.3", "0.0").
+// Integer only, cheap enough to call for every reading. Returns the length.
+size_t chef_scale_format(int32_t weight_mg, char *buf);
+
+#endif
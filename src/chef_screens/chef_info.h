@@ -1,3 +1,5 @@
 #include "lvgl.h"
+#include "chef_screen_manager.h"
+extern const chef_screen_t chef_screen_info;
 
 lv_obj_t* chef_screen_create_info();
\ No newline at end of file
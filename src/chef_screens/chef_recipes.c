@@ -5,175 +5,124 @@
 #include "freertos/event_groups.h"
 #include "driver/gpio.h"
 #include "rom/gpio.h"
-#include "../chef_network/chef_client.h"
+#include "../chef_pack/chef_catalog.h"
 #include "chef_info.h"
+#include "../chef_lvgl/chef_display.h"
 #include "esp_timer.h"
 
-#define DEBOUNCE_DELAY 50
-
 static const char *TAG = "RECIPE_SCREEN";
 
+// The list is virtual: a fixed pool of rows, as many as fit on the screen,
+// shows a window of the catalog that follows the selection. Building the
+// screen and moving through it cost the same for 5 recipes or 5,000.
+#define ROW_HEIGHT   35
+#define ROW_PITCH    40
+#define VISIBLE_ROWS (SCREEN_HEIGHT / ROW_PITCH)
+
 lv_obj_t* recipes_screen;
-static int highlighted_button_recipes = 0;
-TaskHandle_t buttonhandle_recipes = NULL;
-int y_offset = 40;
-
-void recipe_pressed(lv_event_t * e){
-    lv_event_code_t code = lv_event_get_code(e);
-    if (code == LV_EVENT_CLICKED){
-        lv_obj_t *btn = lv_event_get_target(e);
-        lv_obj_t *label = lv_obj_get_child(btn, 0);
-        dish = lv_label_get_text(label);
-        chef_screen_create_info();
-        vTaskDelete(buttonhandle_recipes);
+static lv_obj_t* rows[VISIBLE_ROWS];
+static lv_obj_t* row_labels[VISIBLE_ROWS];
+static uint32_t selected = 0;   // catalog index of the highlighted recipe
+static uint32_t top = 0;        // catalog index shown in the first row
+
+// Point the rows at the recipes in the window; names are read from the
+// catalog as they come into view and referenced in place, not copied
+static void list_refresh(void) {
+    uint32_t count = chef_catalog_count();
+    for (int r = 0; r < VISIBLE_ROWS; r++) {
+        uint32_t i = top + r;
+        if (i >= count) {
+            lv_obj_add_flag(rows[r], LV_OBJ_FLAG_HIDDEN);
+            continue;
+        }
+        lv_obj_remove_flag(rows[r], LV_OBJ_FLAG_HIDDEN);
+        lv_label_set_text_static(row_labels[r], chef_catalog_name(chef_catalog_at(i)));
+        lv_obj_set_state(rows[r], LV_STATE_FOCUSED, i == selected);
     }
 }
 
-void back_pressed(){
-    chef_screen_create_home();
-    vTaskDelete(buttonhandle_recipes);
-    lv_obj_del(recipes_screen);
-}
-
-void handle_select_press_recipes() {
-
-    ESP_LOGI(TAG,"Recipes selected");
-    lv_obj_send_event(lv_obj_get_child(recipes_screen,highlighted_button_recipes), LV_EVENT_CLICKED, NULL);
-
-}
-
-void update_button_highlight_recipes() {
-
-    ESP_LOGI(TAG,"In update highlight");
-
-    lv_obj_set_style_bg_color(lv_obj_get_child(recipes_screen,highlighted_button_recipes-1), lv_color_white(), 0);
-    lv_obj_set_style_bg_color(lv_obj_get_child(recipes_screen,highlighted_button_recipes), lv_palette_main(LV_PALETTE_RED), 0);
-
-    lv_obj_invalidate(recipes_screen);
-    lv_refr_now(NULL);
-
+// UP/DOWN, including auto-repeat while held. The selection wraps at either end.
+static void list_move(void *arg) {
+    uint32_t count = chef_catalog_count();
+    if (count == 0) {
+        return;
+    }
+    int step = (int)(intptr_t)arg;
+    selected = step > 0 ? (selected + 1) % count : (selected + count - 1) % count;
+
+    // scroll only as far as needed to keep the selection in view
+    if (selected < top) {
+        top = selected;
+    } else if (selected >= top + VISIBLE_ROWS) {
+        top = selected - VISIBLE_ROWS + 1;
+    }
+    list_refresh();
 }
 
-void button_task_recipes(void *params) {
-
-    ESP_LOGI(TAG, "Waiting for button press");
-    int current_state;
-    static bool btn_up_released = true;
-    static bool btn_down_released = true;
-    static bool btn_prev_released = true;
-    static bool btn_select_released = true;
-
-    int64_t current_time = esp_timer_get_time();
-
-    while (1) {
-        int64_t next_time = esp_timer_get_time();
-        if (next_time>current_time+1000000){
-        // Handle BTN_NEXT
-            current_state = gpio_get_level(BTN_DOWN);
-            if (current_state == 0 && btn_down_released) {
-                vTaskDelay(pdMS_TO_TICKS(DEBOUNCE_DELAY));
-                if (gpio_get_level(BTN_NEXT) == 0) {
-                    ESP_LOGI("Button Task", "DOWN button pressed");
-                    highlighted_button_recipes = (highlighted_button_recipes + 1) % 2;
-                    update_button_highlight_recipes();
-                    btn_down_released = false;
-                }
-            } else if (current_state == 1) {
-                btn_down_released = true;
-            }
-
-            // Handle BTN_PREV
-            current_state = gpio_get_level(BTN_UP);
-            if (current_state == 0 && btn_up_released) {
-                vTaskDelay(pdMS_TO_TICKS(DEBOUNCE_DELAY));
-                if (gpio_get_level(BTN_UP) == 0) {
-                    ESP_LOGI("Button Task", "UP button pressed");
-                    highlighted_button_recipes = (highlighted_button_recipes - 1) % 2;
-                    update_button_highlight_recipes();
-                    btn_up_released = false;
-                }
-            } else if (current_state == 1) {
-                btn_up_released = true;
-            }
-
-            // Handle BTN_SELECT
-            current_state = gpio_get_level(BTN_SELECT);
-            if (current_state == 0 && btn_select_released) {
-                vTaskDelay(pdMS_TO_TICKS(DEBOUNCE_DELAY));
-                if (gpio_get_level(BTN_SELECT) == 0) {
-                    ESP_LOGI("Button Task", "Select button pressed");
-                    handle_select_press_recipes();
-                    btn_select_released = false;
-                }
-            } else if (current_state == 1) {
-                btn_select_released = true;
-            }
-
-            current_state = gpio_get_level(BTN_PREV);
-            if (current_state == 0 && btn_prev_released) {
-                vTaskDelay(pdMS_TO_TICKS(DEBOUNCE_DELAY));
-                if (gpio_get_level(BTN_PREV) == 0) {
-                    ESP_LOGI("Button Task", "PREV button pressed");
-                    highlighted_button_recipes = (highlighted_button_recipes + 1) % 2;
-                    back_pressed();
-                    btn_prev_released = false;
-                }
-            } else if (current_state == 1) {
-                btn_prev_released = true;
-            }
-
-            vTaskDelay(pdMS_TO_TICKS(10));
-        }
+static void list_open(void *arg) {
+    const chef_pack_recipe_t* recipe = chef_catalog_at(selected);
+    if (recipe) {
+        // The pack string outlives this screen, unlike the label text
+        dish = (char*)chef_catalog_name(recipe);
+        chef_screen_show(CHEF_SCREEN_INFO);
     }
 }
 
+static const chef_input_handler_t recipes_handlers[] = {
+    { BTN_UP,     CHEF_BUTTON_PRESS,  list_move, (void *)-1 },
+    { BTN_UP,     CHEF_BUTTON_REPEAT, list_move, (void *)-1 },
+    { BTN_DOWN,   CHEF_BUTTON_PRESS,  list_move, (void *)1 },
+    { BTN_DOWN,   CHEF_BUTTON_REPEAT, list_move, (void *)1 },
+    { BTN_SELECT, CHEF_BUTTON_PRESS,  list_open, NULL },
+    { 0 },
+};
 
 lv_obj_t* chef_screen_create_recipe() {
     ESP_LOGI(TAG, "Creating recipes screen");
     
     recipes_screen = lv_obj_create(NULL);
     extern lv_style_t screen_background;
+    extern lv_style_t menu_button_focused;
     lv_obj_add_style(recipes_screen, &screen_background, 0);
-    
-    cJSON* cjson = fetch_recipe_json();
-    if (cjson == NULL) {
-        const char *error_ptr = cJSON_GetErrorPtr();
-        if (error_ptr != NULL) {
-            fprintf(stderr, "Error before: %s\n", error_ptr);
-        }
-    }
+    lv_obj_remove_flag(recipes_screen, LV_OBJ_FLAG_SCROLLABLE);
 
-    cJSON *recipes = cJSON_GetObjectItemCaseSensitive(cjson, "recipes");
-    cJSON *recipe;
-
-    int i = 0;
-    cJSON_ArrayForEach(recipe, recipes) {
-        cJSON *name = cJSON_GetObjectItemCaseSensitive(recipe, "name");
-        if (cJSON_IsString(name) && (name->valuestring != NULL)) {
-            lv_obj_t* btn = lv_btn_create(recipes_screen);
-            if (i == 0){
-                lv_obj_set_style_bg_color(btn, lv_palette_main(LV_PALETTE_RED), LV_PART_MAIN | LV_STATE_DEFAULT);
-            }
-            else{
-                lv_obj_set_style_bg_color(btn, lv_color_white(), LV_PART_MAIN | LV_STATE_DEFAULT);
-            }
-            lv_obj_set_size(btn, 100, 35);
-            lv_obj_align(btn, LV_ALIGN_TOP_MID, 0, i*y_offset);
-            i++;
-
-            lv_obj_add_event_cb(btn, recipe_pressed, LV_EVENT_CLICKED, name->valuestring);  // Add an event callback
-
-            lv_obj_t* btn_label = lv_label_create(btn);
-            lv_label_set_text(btn_label, name->valuestring);
-            lv_obj_set_style_text_color(btn_label, lv_color_black(), LV_STATE_DEFAULT);
-            lv_obj_align_to(btn_label, btn, LV_ALIGN_TOP_MID, 0, 5);
-        }
+    if (chef_catalog_count() == 0) {
+        ESP_LOGE(TAG, "No recipes stored");
     }
 
-    xTaskCreatePinnedToCore(button_task_recipes, "button_task", 8192, NULL, 5, &buttonhandle_recipes, 0);
+    for (int r = 0; r < VISIBLE_ROWS; r++) {
+        lv_obj_t* btn = lv_btn_create(recipes_screen);
+        // The selection is tracked here, not by the focus group
+        lv_group_remove_obj(btn);
+        lv_obj_set_style_bg_color(btn, lv_color_white(), LV_PART_MAIN | LV_STATE_DEFAULT);
+        lv_obj_add_style(btn, &menu_button_focused, LV_STATE_FOCUSED);
+        lv_obj_set_size(btn, 100, ROW_HEIGHT);
+        lv_obj_align(btn, LV_ALIGN_TOP_MID, 0, r*ROW_PITCH);
+
+        lv_obj_t* btn_label = lv_label_create(btn);
+        lv_label_set_long_mode(btn_label, LV_LABEL_LONG_DOT);
+        lv_obj_set_width(btn_label, lv_pct(100));
+        lv_obj_set_style_text_align(btn_label, LV_TEXT_ALIGN_CENTER, 0);
+        lv_obj_set_style_text_color(btn_label, lv_color_black(), LV_STATE_DEFAULT);
+        lv_obj_align_to(btn_label, btn, LV_ALIGN_TOP_MID, 0, 5);
+
+        rows[r] = btn;
+        row_labels[r] = btn_label;
+    }
 
-    lv_scr_load(recipes_screen);
-    lv_refr_now(NULL);
+    // a rebuilt screen keeps its place in the catalog
+    if (selected >= chef_catalog_count()) {
+        selected = 0;
+        top = 0;
+    }
+    list_refresh();
 
     return recipes_screen;
-}
\ No newline at end of file
+}
+
+const chef_screen_t chef_screen_recipes = {
+    .name = "recipes",
+    .create = chef_screen_create_recipe,
+    .parent = CHEF_SCREEN_HOME,
+    .handlers = recipes_handlers,
+};
@@ -1 +1,4 @@
+#include "chef_screen_manager.h"
+extern const chef_screen_t chef_screen_recipes;
+
 lv_obj_t* chef_screen_create_recipe();
\ No newline at end of file
@@ -1,95 +1,56 @@
 #include "chef_scale.h"
 #include "chef_styles.h"
 #include "esp_log.h"
-#include "../chef_hx711/HX711.h"
+#include "../chef_scale/chef_scale_service.h"
 #include "../chef_buttons/chef_button.h"
 #include "chef_startup.h"
-#include "esp_timer.h"
-#include "nvs_flash.h"
-
-#define GPIO_DATA   GPIO_NUM_27
-#define GPIO_SCLK   GPIO_NUM_12
-#define AVG_SAMPLES   10
-#define DEBOUNCE_DELAY     50
+#include "../chef_lvgl/chef_ui_queue.h"
 
 static const char *TAG = "SCALE_SCREEN";
 
 lv_obj_t * weight_label;
+static lv_obj_t * stable_label;
 lv_obj_t * screen_scale;
-TaskHandle_t buttonhandle_scale = NULL;
-
-typedef struct {
-    lv_obj_t *label;
-    char text[16];
-} label_update_data_t;
-
-void back_pressed_scale() {
-    chef_screen_create_home();
-    vTaskDelete(buttonhandle_scale);
-    lv_obj_del(screen_scale);
-}
-
-static void label_update_cb(void *data) 
+static chef_scale_sub_t scale_sub = CHEF_SCALE_NO_SUB;
+static int32_t shown_tenths;   // value on weight_label; service task only while subscribed
+static bool shown_valid;
+
+// Runs on the scale service task, once per conversion. The label is only
+// touched when the displayed value changes, so a steady reading at 80 SPS
+// costs no redraw at all.
+static void on_reading(const chef_scale_reading_t *reading, void *ctx)
 {
-    label_update_data_t *update = (label_update_data_t *)data;
-    lv_label_set_text(update->label, update->text);
-    lv_refr_now(NULL);
-
-}
+    if (reading->event == eSTABLE_SETTLED) {
+        chef_ui_set_text(stable_label, LV_SYMBOL_OK " stable");
+    } else if (reading->event == eSTABLE_LOST) {
+        chef_ui_set_text(stable_label, "");
+    }
 
-static void weight_reading_task(void* arg)
-{
-    HX711_init(GPIO_DATA,GPIO_SCLK,eGAIN_128); 
-    HX711_tare();
-    char weight_str[10]; 
-    float weight =0;
+    int32_t tenths = chef_scale_tenths(reading->weight_mg);
+    if (shown_valid && tenths == shown_tenths) {
+        return;
+    }
 
-    label_update_data_t *update_data = malloc(sizeof(label_update_data_t));
-    update_data->label = weight_label;
-    while(1)
-    {
-        weight = HX711_get_units(AVG_SAMPLES);
-        // Format with one decimal place
-        snprintf(update_data->text, sizeof(update_data->text), "%.1f", weight);
-        
-        // Queue the update
-        lv_async_call(label_update_cb, update_data);
-        
-        ESP_LOGI(TAG, "******* weight = %f *********\n ", weight);
-        vTaskDelay(pdMS_TO_TICKS(2000));
+    char weight_str[CHEF_SCALE_TEXT_MAX];
+    chef_scale_format(reading->weight_mg, weight_str);
+    if (chef_ui_set_text(weight_label, weight_str)) {
+        shown_tenths = tenths;
+        shown_valid = true;
     }
 }
 
-static void initialise_weight_sensor(void)
+// The scale only runs while this screen is visible
+static void scale_on_show(void)
 {
-    ESP_LOGI(TAG, "****************** Initialing weight sensor **********");
-    xTaskCreatePinnedToCore(weight_reading_task, "weight_reading_task", 4096, NULL, 1, NULL,0);
+    shown_valid = false;
+    scale_sub = chef_scale_subscribe(on_reading, NULL);
 }
 
-void button_task_scale(void *params) {
-    ESP_LOGI(TAG, "Waiting for button press");
-    int current_state;
-    static bool btn_prev_released = true;
-
-    int64_t current_time = esp_timer_get_time();
-
-    while (1) {
-        int64_t next_time = esp_timer_get_time();
-        if (next_time > current_time + 1000000) {
-            current_state = gpio_get_level(BTN_PREV);
-            if (current_state == 0 && btn_prev_released) {
-                vTaskDelay(pdMS_TO_TICKS(DEBOUNCE_DELAY));
-                if (gpio_get_level(BTN_PREV) == 0) {
-                    ESP_LOGI("Button Task", "PREV button pressed");
-                    back_pressed_scale();
-                    btn_prev_released = false;
-                }
-            } else if (current_state == 1) {
-                btn_prev_released = true;
-            }
-            vTaskDelay(pdMS_TO_TICKS(10));
-        }
-    }
+static void scale_on_hide(void)
+{
+    chef_scale_unsubscribe(scale_sub);
+    scale_sub = CHEF_SCALE_NO_SUB;
+    lv_label_set_text(stable_label, "");
 }
 
 lv_obj_t* chef_screen_create_scale() {
@@ -109,9 +70,14 @@ lv_obj_t* chef_screen_create_scale() {
     lv_label_set_text(title_label, "Weight");
     lv_obj_align(title_label, LV_ALIGN_TOP_MID, 0, 20);
 
-    // Create weight label
+    // Create weight label. Fixed width with centred text: a new value never
+    // changes the label's size or position, so an update invalidates only the
+    // label's own box, not its neighbours or the screen
     weight_label = lv_label_create(screen_scale);
     lv_obj_add_style(weight_label, &label_style, 0);
+    lv_obj_set_width(weight_label, SCREEN_WIDTH);
+    lv_obj_set_style_text_align(weight_label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_label_set_long_mode(weight_label, LV_LABEL_LONG_CLIP);
     lv_label_set_text(weight_label, "0.0");
     lv_obj_align(weight_label, LV_ALIGN_CENTER, 0, 0);
 
@@ -125,13 +91,23 @@ lv_obj_t* chef_screen_create_scale() {
     lv_label_set_text(unit_label, "g");
     lv_obj_align_to(unit_label, weight_label, LV_ALIGN_OUT_BOTTOM_MID, 0, 4);
 
-
-    xTaskCreatePinnedToCore(button_task_scale, "button_task", 8192, NULL, 5, &buttonhandle_scale, 0);
-    nvs_flash_init();
-    initialise_weight_sensor();
-
-    lv_scr_load(screen_scale);
-    lv_refr_now(NULL);
+    // Shown while the reading is settled
+    stable_label = lv_label_create(screen_scale);
+    lv_obj_add_style(stable_label, &unit_label_style, 0);
+    lv_obj_set_width(stable_label, SCREEN_WIDTH);
+    lv_obj_set_style_text_align(stable_label, LV_TEXT_ALIGN_CENTER, 0);
+    lv_label_set_text(stable_label, "");
+    lv_obj_align(stable_label, LV_ALIGN_BOTTOM_MID, 0, -8);
 
     return screen_scale;
-}
\ No newline at end of file
+}
+
+const chef_screen_t chef_screen_scale = {
+    .name = "scale",
+    .create = chef_screen_create_scale,
+    .on_show = scale_on_show,
+    .on_hide = scale_on_hide,
+    .parent = CHEF_SCREEN_HOME,
+    // readings queued for the labels just before on_hide may still be applied
+    .pinned = true,
+};
\ No newline at end of file
@@ -1,10 +1,12 @@
 #include "lvgl.h"
+#include "chef_screen_manager.h"
+#include "../chef_lvgl/chef_display.h"
 
-#define SCREEN_WIDTH      128
-#define SCREEN_HEIGHT     160
 #define ARC_CENTER_X      64
 #define ARC_CENTER_Y      80
 #define ARC_RADIUS        55
 #define MAX_WEIGHT        200
 
+extern const chef_screen_t chef_screen_scale;
+
 lv_obj_t* chef_screen_create_scale();
\ No newline at end of file
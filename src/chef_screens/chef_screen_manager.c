@@ -0,0 +1,113 @@
+#include "esp_log.h"
+#include "chef_screen_manager.h"
+#include "chef_startup.h"
+#include "chef_recipes.h"
+#include "chef_info.h"
+#include "chef_ingredients.h"
+#include "chef_steps.h"
+#include "chef_scale.h"
+#include "chef_timer.h"
+
+static const char *TAG = "SCREEN_MANAGER";
+
+static const chef_screen_t *screens[CHEF_SCREEN_COUNT] = {
+    [CHEF_SCREEN_HOME]         = &chef_screen_home,
+    [CHEF_SCREEN_RECIPES]      = &chef_screen_recipes,
+    [CHEF_SCREEN_INFO]         = &chef_screen_info,
+    [CHEF_SCREEN_INGREDIENTS]  = &chef_screen_ingredients,
+    [CHEF_SCREEN_INSTRUCTIONS] = &chef_screen_instructions,
+    [CHEF_SCREEN_SCALE]        = &chef_screen_scale,
+    [CHEF_SCREEN_TIMER]        = &chef_screen_timer,
+};
+
+typedef struct {
+    lv_obj_t *obj;
+    lv_group_t *group;
+    uint32_t last_used;
+} screen_slot_t;
+
+static screen_slot_t slots[CHEF_SCREEN_COUNT];
+static chef_screen_id_t active = CHEF_SCREEN_COUNT;
+static uint32_t use_counter = 0;
+static int cached_count = 0;
+
+// Drop the least recently used screen that is neither active nor pinned
+static void evict_one(void) {
+    int victim = -1;
+    for (int i = 0; i < CHEF_SCREEN_COUNT; i++) {
+        if (slots[i].obj && i != active && !screens[i]->pinned &&
+            (victim < 0 || slots[i].last_used < slots[victim].last_used)) {
+            victim = i;
+        }
+    }
+    if (victim < 0) {
+        return;
+    }
+
+    ESP_LOGI(TAG, "Evicting %s", screens[victim]->name);
+    lv_obj_delete(slots[victim].obj);
+    lv_group_delete(slots[victim].group);
+    slots[victim].obj = NULL;
+    slots[victim].group = NULL;
+    cached_count--;
+}
+
+bool chef_screen_show(chef_screen_id_t id) {
+    const chef_screen_t *screen = screens[id];
+    screen_slot_t *slot = &slots[id];
+
+    if (!slot->obj) {
+        if (!screen->pinned && cached_count >= CHEF_SCREEN_CACHE_SIZE) {
+            evict_one();
+        }
+        ESP_LOGI(TAG, "Building %s", screen->name);
+        slot->group = lv_group_create();
+        lv_group_set_default(slot->group);
+        slot->obj = screen->create();
+        lv_group_set_default(NULL);
+        if (!slot->obj) {
+            ESP_LOGE(TAG, "Failed to build %s", screen->name);
+            lv_group_delete(slot->group);
+            slot->group = NULL;
+            return false;
+        }
+        if (!screen->pinned) {
+            cached_count++;
+        }
+    }
+
+    if (screen->bind && !screen->bind()) {
+        ESP_LOGE(TAG, "Failed to bind %s", screen->name);
+        return false;
+    }
+
+    if (active != id) {
+        if (active != CHEF_SCREEN_COUNT && screens[active]->on_hide) {
+            screens[active]->on_hide();
+        }
+        active = id;
+        chef_keypad_attach(slot->group, screen->keymap ? screen->keymap : &chef_keymap_menu,
+                           screen->handlers);
+        lv_scr_load(slot->obj);
+        if (screen->on_show) {
+            screen->on_show();
+        }
+    }
+    slot->last_used = ++use_counter;
+    return true;
+}
+
+void chef_screen_back(void) {
+    if (active != CHEF_SCREEN_COUNT) {
+        chef_screen_show(screens[active]->parent);
+    }
+}
+
+static void back_action(void *arg) {
+    chef_screen_back();
+}
+
+const chef_input_handler_t chef_screen_nav_handlers[] = {
+    { BTN_PREV, CHEF_BUTTON_PRESS, back_action, NULL },
+    { 0 },
+};
@@ -0,0 +1,50 @@
+#ifndef CHEF_SCREEN_MANAGER_H
+#define CHEF_SCREEN_MANAGER_H
+
+#include <stdbool.h>
+#include "lvgl.h"
+#include "../chef_lvgl/chef_keypad.h"
+
+// Screens are built once and kept in a bounded cache; navigation switches the
+// active screen with lv_scr_load instead of rebuilding the widget tree. Pinned
+// screens stay cached and do not count against CHEF_SCREEN_CACHE_SIZE.
+// Each cached screen owns an lv_group_t; widgets that take focus (buttons,
+// spinbox) join it automatically while create runs. All functions run on the
+// LVGL task.
+
+#define CHEF_SCREEN_CACHE_SIZE 3     // plus the pinned screens: at most 5 built at once
+
+typedef enum {
+    CHEF_SCREEN_HOME,
+    CHEF_SCREEN_RECIPES,
+    CHEF_SCREEN_INFO,
+    CHEF_SCREEN_INGREDIENTS,
+    CHEF_SCREEN_INSTRUCTIONS,
+    CHEF_SCREEN_SCALE,
+    CHEF_SCREEN_TIMER,
+    CHEF_SCREEN_COUNT
+} chef_screen_id_t;
+
+typedef struct {
+    const char *name;
+    lv_obj_t* (*create)(void);  // build the widget tree; NULL on failure
+    bool (*bind)(void);         // optional: refresh data that may have changed (e.g. dish)
+    void (*on_show)(void);      // optional: screen became active
+    void (*on_hide)(void);      // optional: another screen is about to be shown
+    chef_screen_id_t parent;    // shown by the back button
+    const chef_keymap_t *keymap;  // NULL: chef_keymap_menu
+    const chef_input_handler_t *handlers;  // optional: checked before chef_screen_nav_handlers
+    bool pinned;                // never evicted: its widgets hold state or are updated while hidden
+} chef_screen_t;
+
+// Show a screen, building it first if it is not cached. If building or binding
+// fails the current screen stays active and false is returned.
+bool chef_screen_show(chef_screen_id_t id);
+
+// Show the active screen's parent
+void chef_screen_back(void);
+
+// Input handlers shared by every screen (back button); pass to chef_keypad_init
+extern const chef_input_handler_t chef_screen_nav_handlers[];
+
+#endif
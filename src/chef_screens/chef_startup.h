@@ -1,4 +1,6 @@
 #include "lvgl.h"
+#include "chef_screen_manager.h"
 extern char* dish;
+extern const chef_screen_t chef_screen_home;
 
 lv_obj_t* chef_screen_create_home();
\ No newline at end of file
@@ -1,2 +1,5 @@
 #include "lvgl.h"
+#include "chef_screen_manager.h"
+extern const chef_screen_t chef_screen_instructions;
+
 lv_obj_t* chef_screen_create_instructions();
\ No newline at end of file
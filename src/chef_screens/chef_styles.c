@@ -5,6 +5,7 @@ lv_style_t screen_background;
 lv_style_t icon_default;
 lv_style_t label_style;
 lv_style_t arc_style;
+lv_style_t menu_button_focused;
 
 static void _init_screen_background(void)
 {
@@ -35,10 +36,18 @@ static void _init_label_default(void)
     lv_style_set_text_color(&label_style, lv_color_hex(0x333333));
 }
 
+// Focused menu button, moved by the keypad group
+static void _init_menu_button_focused(void)
+{
+    lv_style_init(&menu_button_focused);
+    lv_style_set_bg_color(&menu_button_focused, lv_palette_main(LV_PALETTE_RED));
+}
+
 void chef_init_styles(void)
 {
     _init_screen_background();
     _init_icon_default();
     _init_arc_default();
     _init_label_default();
+    _init_menu_button_focused();
 }
\ No newline at end of file
@@ -6,10 +6,10 @@
 #include "chef_startup.h"
 #include "chef_timer.h"
 #include "../chef_buttons/chef_button.h"
+#include "../chef_lvgl/chef_ui_queue.h"
 
 #define TAG                 "TIMER_SCREEN"
 #define TIMER_PERIOD_MS    5000
-#define DEBOUNCE_DELAY     50
 #define MAX_TIME_SECONDS   3600    // 1 hour
 #define TIME_STEP_SECONDS  30      // 30-second increments
 
@@ -29,7 +29,7 @@ typedef struct {
 static TimerUI ui;
 static TimerState state = {0};
 static gptimer_handle_t gptimer = NULL;
-static TaskHandle_t buttonhandle_timer = NULL;
+static TaskHandle_t countdown_task = NULL;
 lv_obj_t *timer_screen;
 
 static void timer_control(bool start) {
@@ -83,9 +83,67 @@ static void timer_control(bool start) {
         
         ESP_LOGI(TAG, "Timer stopped");
     }
-    
-    // Refresh the display
-    lv_refr_now(NULL);
+}
+
+static void start_btn_clicked(lv_event_t *e) {
+    ESP_LOGI(TAG, "Select button pressed, toggling timer state");
+    timer_control(!state.is_running);
+}
+
+// Move the spinbox by `steps` TIME_STEP_SECONDS, clamped to 0..MAX_TIME_SECONDS
+static void spinbox_step(int steps) {
+    int32_t current_value = lv_spinbox_get_value(ui.spinbox);
+    int32_t new_value = current_value + steps * TIME_STEP_SECONDS;
+
+    if (new_value > MAX_TIME_SECONDS) {
+        ESP_LOGW(TAG, "Max time limit reached: %d", MAX_TIME_SECONDS);
+        new_value = MAX_TIME_SECONDS;
+    } else if (new_value < 0) {
+        ESP_LOGW(TAG, "Min time limit reached: 0");
+        new_value = 0;
+    }
+
+    if (new_value != current_value) {
+        lv_spinbox_set_value(ui.spinbox, new_value);
+        ESP_LOGI(TAG, "Spinbox changed from %ld to %ld", current_value, new_value);
+    }
+}
+
+// Steps from REPEAT events not yet applied. LVGL task only.
+static int pending_steps = 0;
+static bool apply_scheduled = false;
+
+static void spinbox_apply_pending(void *arg) {
+    spinbox_step(pending_steps);
+    pending_steps = 0;
+    apply_scheduled = false;
+}
+
+// Holding UP/DOWN sends REPEAT events at an accelerating rate. The UI queue is
+// drained right before lv_timer_handler, so every repeat that arrived for this
+// frame is summed and the spinbox is updated once, by the async call.
+static void spinbox_repeat(void *direction) {
+    pending_steps += (int)(intptr_t)direction;
+    if (!apply_scheduled) {
+        apply_scheduled = true;
+        lv_async_call(spinbox_apply_pending, NULL);
+    }
+}
+
+static const chef_input_handler_t timer_handlers[] = {
+    { BTN_UP,   CHEF_BUTTON_REPEAT, spinbox_repeat, (void *)1 },
+    { BTN_DOWN, CHEF_BUTTON_REPEAT, spinbox_repeat, (void *)-1 },
+    { 0 },
+};
+
+// The start button keeps focus; UP/DOWN arrive here and adjust the spinbox
+static void start_btn_key(lv_event_t *e) {
+    uint32_t key = lv_event_get_key(e);
+    if (key == LV_KEY_UP) {
+        spinbox_step(1);
+    } else if (key == LV_KEY_DOWN) {
+        spinbox_step(-1);
+    }
 }
 
 bool IRAM_ATTR timer_callback(gptimer_handle_t timer, 
@@ -96,6 +154,9 @@ bool IRAM_ATTR timer_callback(gptimer_handle_t timer,
 }
 
 static void timer_init(void) {
+    if (gptimer) {
+        return;
+    }
     ESP_LOGI(TAG, "Initializing hardware timer");
     gptimer_config_t timer_config = {
         .clk_src = GPTIMER_CLK_SRC_DEFAULT,
@@ -112,82 +173,6 @@ static void timer_init(void) {
     ESP_LOGI(TAG, "Hardware timer initialization complete");
 }
 
-void back_pressed_timer(){
-    chef_screen_create_home();
-    vTaskDelete(buttonhandle_timer);
-    lv_obj_del(timer_screen);
-}
-
-
-static void button_handler_task(void *params) {
-    ESP_LOGI(TAG, "Button handler task initialized");
-    static bool button_states[4] = {true, true, true, true}; // Released states for NEXT, PREV, SELECT
-
-    while (1) {
-        // Handle BTN_NEXT (increment)
-        if (gpio_get_level(BTN_UP) == 0 && button_states[0]) {
-            vTaskDelay(pdMS_TO_TICKS(DEBOUNCE_DELAY));
-            if (gpio_get_level(BTN_UP) == 0) {
-                uint32_t current_value = lv_spinbox_get_value(ui.spinbox);
-                ESP_LOGI(TAG, "Next button pressed, current value: %lu", current_value);
-                if (current_value < MAX_TIME_SECONDS) {
-                    lv_spinbox_increment(ui.spinbox);
-                    ESP_LOGI(TAG, "Incremented to: %lu", lv_spinbox_get_value(ui.spinbox));
-                    lv_refr_now(NULL);
-                } else {
-                    ESP_LOGW(TAG, "Max time limit reached: %d", MAX_TIME_SECONDS);
-                }
-                button_states[0] = false;
-            }
-        } else if (gpio_get_level(BTN_UP) == 1) {
-            button_states[0] = true;
-        }
-
-        // Handle BTN_PREV (decrement)
-        if (gpio_get_level(BTN_DOWN) == 0 && button_states[1]) {
-            vTaskDelay(pdMS_TO_TICKS(DEBOUNCE_DELAY));
-            if (gpio_get_level(BTN_DOWN) == 0) {
-                uint32_t current_value = lv_spinbox_get_value(ui.spinbox);
-                ESP_LOGI(TAG, "Prev button pressed, current value: %lu", current_value);
-                if (current_value > 0) {
-                    lv_spinbox_decrement(ui.spinbox);
-                    ESP_LOGI(TAG, "Decremented to: %lu", lv_spinbox_get_value(ui.spinbox));
-                    lv_refr_now(NULL);
-                } else {
-                    ESP_LOGW(TAG, "Min time limit reached: 0");
-                }
-                button_states[1] = false;
-            }
-        } else if (gpio_get_level(BTN_DOWN) == 1) {
-            button_states[1] = true;
-        }
-
-        // Handle BTN_SELECT (start/stop)
-        if (gpio_get_level(BTN_SELECT) == 0 && button_states[2]) {
-            vTaskDelay(pdMS_TO_TICKS(DEBOUNCE_DELAY));
-            if (gpio_get_level(BTN_SELECT) == 0) {
-                ESP_LOGI(TAG, "Select button pressed, toggling timer state");
-                timer_control(!state.is_running);
-                button_states[2] = false;
-            }
-        } else if (gpio_get_level(BTN_SELECT) == 1) {
-            button_states[2] = true;
-        }
-
-        if (gpio_get_level(BTN_PREV) == 0 && button_states[3]) {
-            vTaskDelay(pdMS_TO_TICKS(DEBOUNCE_DELAY));
-            if (gpio_get_level(BTN_PREV) == 0) {
-                ESP_LOGI(TAG, "Select button pressed, toggling timer state");
-                back_pressed_timer();
-                button_states[3] = false;
-            }
-        } else if (gpio_get_level(BTN_PREV) == 1) {
-            button_states[3] = true;
-        }
-
-        vTaskDelay(pdMS_TO_TICKS(10));
-    }
-}
 
 static void format_time(uint32_t total_seconds, char *buffer, size_t buffer_size) {
     uint32_t minutes = total_seconds / 60;
@@ -204,9 +189,8 @@ static void timer_countdown_task(void *pvParameters) {
             // Format current time
             format_time(state.remaining_time, time_str, sizeof(time_str));
             
-            // Update the label text directly
-            lv_label_set_text(ui.timer_label, time_str);
-            lv_refr_now(NULL);
+            // Hand the text to the LVGL task
+            chef_ui_set_text(ui.timer_label, time_str);
             // Decrement counter
             state.remaining_time--;
             
@@ -214,7 +198,7 @@ static void timer_countdown_task(void *pvParameters) {
                 ESP_LOGI(TAG, "Timer expired!");
                 state.is_running = false;
                 state.is_expired = true;
-                lv_label_set_text(ui.timer_label, "00:00");
+                chef_ui_set_text(ui.timer_label, "00:00");
                 turn_on_buzzer();
             }
         }
@@ -254,17 +238,30 @@ lv_obj_t* chef_create_timer_screen(void) {
     lv_obj_set_size(ui.start_btn, 120, 50);
     lv_obj_align(ui.start_btn, LV_ALIGN_BOTTOM_MID, 0, -20);
     lv_obj_set_style_bg_color(ui.start_btn, lv_color_make(0, 255, 0), 0);
+    lv_obj_add_event_cb(ui.start_btn, start_btn_clicked, LV_EVENT_CLICKED, NULL);
+    lv_obj_add_event_cb(ui.start_btn, start_btn_key, LV_EVENT_KEY, NULL);
+    // The spinbox joined the group when it was created; only the button takes focus
+    lv_group_remove_obj(ui.spinbox);
 
     lv_obj_t *btn_label = lv_label_create(ui.start_btn);
     lv_label_set_text(btn_label, "Start");
     lv_obj_center(btn_label);
 
-    xTaskCreate(timer_countdown_task, "timer_task", 4096, NULL, 5, NULL);
-
-    xTaskCreate(button_handler_task, "button_task", 4096, NULL, 5, &buttonhandle_timer);
-
-    lv_scr_load(timer_screen);
-    lv_refr_now(NULL);
+    // The countdown keeps running while other screens are shown
+    if (!countdown_task) {
+        xTaskCreate(timer_countdown_task, "timer_task", 4096, NULL, 5, &countdown_task);
+    }
 
     return timer_screen;
-}
\ No newline at end of file
+}
+
+const chef_screen_t chef_screen_timer = {
+    .name = "timer",
+    .create = chef_create_timer_screen,
+    .parent = CHEF_SCREEN_HOME,
+    .keymap = &chef_keymap_arrows,
+    .handlers = timer_handlers,
+    // the countdown task keeps writing to timer_label, and the button shows
+    // whether it is running; a rebuilt screen would lose both
+    .pinned = true,
+};
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include <string.h>
+#include "chef_pack_writer.h"
+
+#define ALIGN4(n) (((n) + 3u) & ~3u)
+
+void chef_pack_writer_init(chef_pack_writer_t *w, const chef_pack_io_t *io,
+                           uint32_t capacity, uint32_t max_recipes) {
+    memset(w, 0, sizeof(*w));
+    w->io = *io;
+    w->capacity = capacity;
+    w->max_recipes = max_recipes;
+    w->header.recipes_off = sizeof(chef_pack_t);
+    uint64_t data = ALIGN4(sizeof(chef_pack_t) + (uint64_t)max_recipes * sizeof(chef_pack_recipe_t));
+    w->pos = data;
+    w->failed = data > capacity;
+}
+
+static bool flush(chef_pack_writer_t *w) {
+    if (w->buf_len && !w->failed) {
+        w->failed = !w->io.write(w->io.ctx, w->pos - w->buf_len, w->buf, w->buf_len);
+    }
+    w->buf_len = 0;
+    return !w->failed;
+}
+
+static bool append(chef_pack_writer_t *w, const void *data, size_t len) {
+    if (w->failed || len > w->capacity - w->pos) {
+        w->failed = true;
+        return false;
+    }
+    const uint8_t *p = data;
+    while (len) {
+        if (w->buf_len == sizeof(w->buf) && !flush(w)) {
+            return false;
+        }
+        size_t n = sizeof(w->buf) - w->buf_len;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(w->buf + w->buf_len, p, n);
+        w->buf_len += n;
+        w->pos += n;
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+static const char *ingredient_field(const cJSON *ingredient, const char *key) {
+    const cJSON *field = cJSON_GetObjectItemCaseSensitive(ingredient, key);
+    return cJSON_IsString(field) ? field->valuestring : NULL;
+}
+
+static bool is_ingredient(const cJSON *ingredient) {
+    return ingredient_field(ingredient, "item") && ingredient_field(ingredient, "quantity");
+}
+
+// Strings are laid out in the order they are appended: name, each ingredient's
+// item and quantity, then the steps. next is the offset the string gets.
+static uint32_t place(uint32_t *next, const char *s) {
+    uint32_t off = *next;
+    *next += strlen(s) + 1;
+    return off;
+}
+
+bool chef_pack_writer_add(chef_pack_writer_t *w, const cJSON *recipe) {
+    const cJSON *name = cJSON_GetObjectItemCaseSensitive(recipe, "name");
+    if (w->failed || !cJSON_IsString(name)) {
+        return false;
+    }
+    if (w->header.recipe_count >= w->max_recipes) {
+        w->failed = true;
+        return false;
+    }
+
+    const cJSON *ingredients = cJSON_GetObjectItemCaseSensitive(recipe, "ingredients");
+    const cJSON *instructions = cJSON_GetObjectItemCaseSensitive(recipe, "instructions");
+    const cJSON *item;
+    uint32_t ingredient_count = 0, step_count = 0;
+    cJSON_ArrayForEach(item, ingredients) {
+        ingredient_count += is_ingredient(item) && ingredient_count < UINT16_MAX;
+    }
+    cJSON_ArrayForEach(item, instructions) {
+        step_count += cJSON_IsString(item) && step_count < UINT16_MAX;
+    }
+
+    chef_pack_recipe_t rec = {
+        .ingredients_off = w->pos,
+        .steps_off = w->pos + ingredient_count * sizeof(chef_pack_ingredient_t),
+        .ingredient_count = ingredient_count,
+        .step_count = step_count,
+    };
+    uint32_t next = rec.steps_off + step_count * sizeof(chef_pack_step_t);
+    rec.name = place(&next, name->valuestring);
+
+    // records first, with the offsets their strings will get
+    uint32_t n = 0;
+    cJSON_ArrayForEach(item, ingredients) {
+        if (n < ingredient_count && is_ingredient(item)) {
+            chef_pack_ingredient_t ing;
+            ing.item = place(&next, ingredient_field(item, "item"));
+            ing.quantity = place(&next, ingredient_field(item, "quantity"));
+            append(w, &ing, sizeof(ing));
+            n++;
+        }
+    }
+    n = 0;
+    cJSON_ArrayForEach(item, instructions) {
+        if (n < step_count && cJSON_IsString(item)) {
+            chef_pack_step_t step = { .text = place(&next, item->valuestring) };
+            append(w, &step, sizeof(step));
+            n++;
+        }
+    }
+
+    // then the strings, in the same order
+    append(w, name->valuestring, strlen(name->valuestring) + 1);
+    n = 0;
+    cJSON_ArrayForEach(item, ingredients) {
+        if (n < ingredient_count && is_ingredient(item)) {
+            const char *text = ingredient_field(item, "item");
+            append(w, text, strlen(text) + 1);
+            text = ingredient_field(item, "quantity");
+            append(w, text, strlen(text) + 1);
+            n++;
+        }
+    }
+    n = 0;
+    cJSON_ArrayForEach(item, instructions) {
+        if (n < step_count && cJSON_IsString(item)) {
+            append(w, item->valuestring, strlen(item->valuestring) + 1);
+            n++;
+        }
+    }
+    static const uint8_t pad[3] = { 0 };
+    append(w, pad, ALIGN4(w->pos) - w->pos);
+    if (w->failed) {
+        return false;
+    }
+
+    uint32_t slot = w->header.recipes_off + w->header.recipe_count * sizeof(chef_pack_recipe_t);
+    if (!w->io.write(w->io.ctx, slot, &rec, sizeof(rec))) {
+        w->failed = true;
+        return false;
+    }
+    w->header.recipe_count++;
+    w->header.ingredient_count += ingredient_count;
+    w->header.step_count += step_count;
+    return true;
+}
+
+bool chef_pack_writer_finish(chef_pack_writer_t *w, uint32_t generation) {
+    if (!flush(w)) {
+        return false;
+    }
+
+    // read the body back rather than summing as it goes: the recipe table is
+    // written out of order, and this also catches a bad write
+    uint32_t crc = 0;
+    for (uint32_t off = sizeof(chef_pack_t); off < w->pos; ) {
+        size_t n = w->pos - off < sizeof(w->buf) ? w->pos - off : sizeof(w->buf);
+        if (!w->io.read(w->io.ctx, off, w->buf, n)) {
+            w->failed = true;
+            return false;
+        }
+        crc = chef_pack_crc32(crc, w->buf, n);
+        off += n;
+    }
+
+    chef_pack_t *h = &w->header;
+    h->magic = CHEF_PACK_MAGIC;
+    h->version = CHEF_PACK_VERSION;
+    h->header_size = sizeof(chef_pack_t);
+    h->generation = generation;
+    h->size = w->pos;
+    h->crc = crc;
+    w->failed = !w->io.write(w->io.ctx, 0, h, sizeof(*h));
+    return !w->failed;
+}
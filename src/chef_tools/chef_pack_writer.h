@@ -0,0 +1,47 @@
+#ifndef CHEF_PACK_WRITER_H
+#define CHEF_PACK_WRITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "cJSON.h"
+#include "chef_pack/chef_pack.h"
+
+// Writing. The image is produced front to back in one pass, a recipe at a
+// time, through these callbacks; only a few hundred bytes are staged in RAM.
+// Offsets are relative to the start of the image. Bytes that are never
+// written (unused recipe table entries) must read back the same every time.
+typedef struct {
+    bool (*write)(void *ctx, uint32_t offset, const void *data, size_t len);
+    bool (*read)(void *ctx, uint32_t offset, void *data, size_t len);
+    void *ctx;
+} chef_pack_io_t;
+
+#define CHEF_PACK_WRITE_BUF 256
+
+typedef struct {
+    chef_pack_io_t io;
+    uint32_t capacity;          // bytes available for the image
+    uint32_t max_recipes;       // recipe table entries reserved after the header
+    chef_pack_t header;         // counts so far
+    uint32_t pos;               // where the next recipe's data goes
+    uint8_t buf[CHEF_PACK_WRITE_BUF];  // data not yet written, it belongs at pos - buf_len
+    size_t buf_len;
+    bool failed;                // out of space or an io error, the pack is abandoned
+} chef_pack_writer_t;
+
+void chef_pack_writer_init(chef_pack_writer_t *w, const chef_pack_io_t *io,
+                           uint32_t capacity, uint32_t max_recipes);
+
+// Append a recipe as it comes from the catalog JSON: a "name" string, an
+// "ingredients" array of {"item", "quantity"} strings and an "instructions"
+// array of strings. Entries of the wrong type are left out, as the screens
+// always did. Returns false if the recipe has no name, or once the writer
+// has failed.
+bool chef_pack_writer_add(chef_pack_writer_t *w, const cJSON *recipe);
+
+// Flush, then write the header. Returns false if the pack could not be
+// completed; the previous one is untouched either way.
+bool chef_pack_writer_finish(chef_pack_writer_t *w, uint32_t generation);
+
+#endif
@@ -0,0 +1,246 @@
+// Recipe compiler: checks a catalog against the schema, normalizes its
+// quantities and writes the recipe pack the device downloads, so a bad
+// catalog is caught here instead of showing up as an empty list on screen.
+//
+//   chef_packc [-o FILE] [--max-bytes N] recipes.json
+//
+// Writes nothing and exits non-zero if the catalog has errors or the pack
+// does not fit in a flash slot. --max-bytes can only lower that limit.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "chef_pack/chef_pack.h"
+#include "chef_network/chef_recipe_stream.h"
+#include "chef_recipe_check.h"
+#include "chef_pack_writer.h"
+
+#define DEFAULT_OUT "recipes.pack"
+#define LOAD_RUNS   100     // opens averaged for the load time
+
+typedef struct {
+    chef_recipe_report_t report;
+    char **names;               // every recipe name seen, to catch duplicates
+    int count;
+    chef_pack_writer_t *pack;   // second pass only
+} compile_t;
+
+static int64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static bool image_write(void *ctx, uint32_t offset, const void *data, size_t len) {
+    memcpy((uint8_t *)ctx + offset, data, len);
+    return true;
+}
+
+static bool image_read(void *ctx, uint32_t offset, void *data, size_t len) {
+    memcpy(data, (uint8_t *)ctx + offset, len);
+    return true;
+}
+
+// First pass: check every recipe and count them, so the pack's recipe table
+// can be sized exactly
+static bool check_recipe(cJSON *recipe, void *arg) {
+    compile_t *c = arg;
+    int index = c->count++;
+    if (chef_recipe_check(recipe, index, &c->report)) {
+        const char *name = cJSON_GetObjectItemCaseSensitive(recipe, "name")->valuestring;
+        // the device looks recipes up by ID, so IDs must be as unique as names
+        for (int i = 0; i < index; i++) {
+            if (!c->names[i]) {
+                continue;
+            }
+            if (strcmp(c->names[i], name) == 0) {
+                fprintf(stderr, "recipe %d (%s): error: same name as recipe %d\n", index, name, i);
+                c->report.errors++;
+            } else if (chef_pack_name_id(c->names[i]) == chef_pack_name_id(name)) {
+                fprintf(stderr, "recipe %d (%s): error: same ID as recipe %d (%s), rename one\n",
+                        index, name, i, c->names[i]);
+                c->report.errors++;
+            }
+        }
+        c->names = realloc(c->names, c->count * sizeof(*c->names));
+        c->names[index] = strdup(name);
+    } else {
+        c->names = realloc(c->names, c->count * sizeof(*c->names));
+        c->names[index] = NULL;
+    }
+    cJSON_Delete(recipe);
+    return true;
+}
+
+// Second pass: the catalog is known to be clean, normalize again and write
+static bool pack_recipe(cJSON *recipe, void *arg) {
+    compile_t *c = arg;
+    chef_recipe_check(recipe, c->count++, &c->report);
+    chef_pack_writer_add(c->pack, recipe);
+    cJSON_Delete(recipe);
+    return !c->pack->failed;
+}
+
+static bool stream_file(const char *json, size_t len, chef_recipe_cb_t cb, compile_t *c) {
+    chef_recipe_stream_t *stream = malloc(sizeof(*stream));
+    chef_recipe_stream_init(stream, cb, c);
+    bool ok = chef_recipe_stream_feed(stream, json, len);
+    ok = chef_recipe_stream_finish(stream) && ok;
+    if (stream->skipped) {
+        fprintf(stderr, "error: %d elements of \"recipes\" are not objects\n", stream->skipped);
+        c->report.errors += stream->skipped;
+    }
+    free(stream);
+    return ok;
+}
+
+static char *read_file(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return NULL;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *data = malloc(size > 0 ? size : 1);
+    *len = fread(data, 1, size, f);
+    fclose(f);
+    return data;
+}
+
+static void print_stats(const chef_pack_t *pack, size_t json_len, uint32_t max_bytes) {
+    uint32_t table = pack->recipe_count * sizeof(chef_pack_recipe_t);
+    uint32_t records = pack->ingredient_count * sizeof(chef_pack_ingredient_t) +
+                       pack->step_count * sizeof(chef_pack_step_t);
+    uint32_t strings = pack->size - pack->header_size - table - records;
+
+    printf("recipes      %8u\n", (unsigned)pack->recipe_count);
+    printf("ingredients  %8u\n", (unsigned)pack->ingredient_count);
+    printf("steps        %8u\n", (unsigned)pack->step_count);
+    printf("header       %8u bytes\n", (unsigned)pack->header_size);
+    printf("recipe table %8u bytes\n", (unsigned)table);
+    printf("records      %8u bytes\n", (unsigned)records);
+    printf("strings      %8u bytes, padding included\n", (unsigned)strings);
+    printf("pack         %8u bytes, %.1f%% of a %u byte slot, %.1f%% of the JSON\n", (unsigned)pack->size,
+           100.0 * pack->size / max_bytes, (unsigned)max_bytes, json_len ? 100.0 * pack->size / json_len : 0.0);
+
+    // Loading is the CRC and bounds check chef_pack_open does at boot; walking
+    // touches every string the screens can show
+    int64_t start = now_ns();
+    for (int i = 0; i < LOAD_RUNS; i++) {
+        if (!chef_pack_open(pack, pack->size)) {
+            fprintf(stderr, "error: the pack does not verify\n");
+        }
+    }
+    int64_t open_ns = (now_ns() - start) / LOAD_RUNS;
+
+    start = now_ns();
+    size_t text = 0;
+    for (uint32_t i = 0; i < pack->recipe_count; i++) {
+        const chef_pack_recipe_t *recipe = chef_pack_recipe(pack, i);
+        const chef_pack_ingredient_t *ingredients = chef_pack_ingredients(pack, recipe);
+        const chef_pack_step_t *steps = chef_pack_steps(pack, recipe);
+        text += strlen(chef_pack_str(pack, recipe->name));
+        for (uint16_t j = 0; j < recipe->ingredient_count; j++) {
+            text += strlen(chef_pack_str(pack, ingredients[j].item));
+            text += strlen(chef_pack_str(pack, ingredients[j].quantity));
+        }
+        for (uint16_t j = 0; j < recipe->step_count; j++) {
+            text += strlen(chef_pack_str(pack, steps[j].text));
+        }
+    }
+    int64_t walk_ns = now_ns() - start;
+
+    printf("load         %8.1f us (host, CRC and bounds of %u bytes)\n", open_ns / 1000.0,
+           (unsigned)(pack->size - pack->header_size));
+    printf("walk         %8.1f us (host, %zu bytes of text)\n", walk_ns / 1000.0, text);
+}
+
+static int usage(const char *argv0) {
+    fprintf(stderr, "usage: %s [-o FILE] [--max-bytes N] recipes.json\n", argv0);
+    return 2;
+}
+
+int main(int argc, char **argv) {
+    const char *in_path = NULL;
+    const char *out_path = DEFAULT_OUT;
+    uint32_t max_bytes = CHEF_PACK_MAX_SIZE;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else if (strcmp(argv[i], "--max-bytes") == 0 && i + 1 < argc) {
+            // only lowers the limit: the device's flash slot is CHEF_PACK_MAX_SIZE
+            char *end;
+            unsigned long n = strtoul(argv[++i], &end, 0);
+            if (*end || n == 0 || n > CHEF_PACK_MAX_SIZE) {
+                fprintf(stderr, "--max-bytes: %s is not between 1 and %u\n", argv[i], (unsigned)CHEF_PACK_MAX_SIZE);
+                return 2;
+            }
+            max_bytes = n;
+        } else if (argv[i][0] != '-' && !in_path) {
+            in_path = argv[i];
+        } else {
+            return usage(argv[0]);
+        }
+    }
+    if (!in_path) {
+        return usage(argv[0]);
+    }
+
+    size_t json_len;
+    char *json = read_file(in_path, &json_len);
+    if (!json) {
+        fprintf(stderr, "Cannot open %s\n", in_path);
+        return 1;
+    }
+
+    compile_t c = { .report = { .log = stderr } };
+    bool parsed = stream_file(json, json_len, check_recipe, &c);
+    for (int i = 0; i < c.count; i++) {
+        free(c.names[i]);
+    }
+    free(c.names);
+    if (!parsed) {
+        fprintf(stderr, "%s: not a catalog document\n", in_path);
+        free(json);
+        return 1;
+    }
+    if (c.count > CHEF_PACK_MAX_RECIPES) {
+        fprintf(stderr, "error: %d recipes, at most %d fit\n", c.count, CHEF_PACK_MAX_RECIPES);
+        c.report.errors++;
+    }
+    if (c.report.errors) {
+        fprintf(stderr, "%s: %d errors, %d warnings, no pack written\n", in_path,
+                c.report.errors, c.report.warnings);
+        free(json);
+        return 1;
+    }
+
+    uint8_t *image = calloc(1, max_bytes);
+    chef_pack_io_t io = { .write = image_write, .read = image_read, .ctx = image };
+    chef_pack_writer_t *pack = malloc(sizeof(*pack));
+    chef_pack_writer_init(pack, &io, max_bytes, c.count);
+    c = (compile_t){ .pack = pack };
+    bool ok = stream_file(json, json_len, pack_recipe, &c) && chef_pack_writer_finish(pack, 0);
+    free(pack);
+    free(json);
+    if (!ok) {
+        fprintf(stderr, "error: the pack does not fit in %u bytes\n", (unsigned)max_bytes);
+        free(image);
+        return 1;
+    }
+
+    const chef_pack_t *out = (const chef_pack_t *)image;
+    FILE *f = fopen(out_path, "wb");
+    if (!f || fwrite(image, 1, out->size, f) != out->size || fclose(f) != 0) {
+        fprintf(stderr, "Cannot write %s\n", out_path);
+        free(image);
+        return 1;
+    }
+
+    printf("%s -> %s\n", in_path, out_path);
+    print_stats(out, json_len, max_bytes);
+    free(image);
+    return 0;
+}
@@ -0,0 +1,245 @@
+#include <ctype.h>
+#include <strings.h>
+#include <stdarg.h>
+#include <string.h>
+#include "chef_recipe_check.h"
+
+static const struct {
+    const char *glyph;
+    const char *text;
+} fractions[] = {
+    { "\xC2\xBD", "1/2" },      // ½
+    { "\xC2\xBC", "1/4" },      // ¼
+    { "\xC2\xBE", "3/4" },      // ¾
+    { "\xE2\x85\x93", "1/3" },  // ⅓
+    { "\xE2\x85\x94", "2/3" },  // ⅔
+    { "\xE2\x85\x9B", "1/8" },  // ⅛
+};
+
+// Metric units are written against the amount ("200g"), the rest after a space
+static const struct {
+    const char *name;
+    const char *unit;
+    bool attached;
+} units[] = {
+    { "g", "g", true }, { "gr", "g", true }, { "gram", "g", true }, { "grams", "g", true },
+    { "kg", "kg", true }, { "kilogram", "kg", true }, { "kilograms", "kg", true },
+    { "ml", "ml", true }, { "milliliter", "ml", true }, { "milliliters", "ml", true },
+    { "millilitre", "ml", true }, { "millilitres", "ml", true },
+    { "l", "l", true }, { "liter", "l", true }, { "liters", "l", true },
+    { "litre", "l", true }, { "litres", "l", true },
+    { "tbsp", "tbsp", false }, { "tbs", "tbsp", false },
+    { "tablespoon", "tbsp", false }, { "tablespoons", "tbsp", false },
+    { "tsp", "tsp", false }, { "teaspoon", "tsp", false }, { "teaspoons", "tsp", false },
+    { "cup", "cup", false }, { "cups", "cup", false },
+    { "oz", "oz", false }, { "ounce", "oz", false }, { "ounces", "oz", false },
+    { "lb", "lb", false }, { "lbs", "lb", false }, { "pound", "lb", false }, { "pounds", "lb", false },
+};
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+static void put(char *out, size_t size, size_t *len, const char *s, size_t n) {
+    while (n-- && *len + 1 < size) {
+        out[(*len)++] = *s++;
+    }
+    out[*len] = '\0';
+}
+
+// Trim, collapse whitespace and spell out fractions ("1½" -> "1 1/2")
+static void simplify(const char *in, char *out, size_t size) {
+    size_t len = 0;
+    bool space = false;
+    out[0] = '\0';
+    while (*in) {
+        if (isspace((unsigned char)*in)) {
+            space = len > 0;
+            in++;
+            continue;
+        }
+        const char *text = NULL;
+        size_t glyph_len = 1;
+        for (size_t i = 0; i < ARRAY_SIZE(fractions); i++) {
+            size_t n = strlen(fractions[i].glyph);
+            if (strncmp(in, fractions[i].glyph, n) == 0) {
+                text = fractions[i].text;
+                glyph_len = n;
+                break;
+            }
+        }
+        if (text && len > 0 && isdigit((unsigned char)out[len - 1])) {
+            space = true;
+        }
+        if (space) {
+            put(out, size, &len, " ", 1);
+            space = false;
+        }
+        if (text) {
+            put(out, size, &len, text, strlen(text));
+        } else {
+            put(out, size, &len, in, 1);
+        }
+        in += glyph_len;
+    }
+}
+
+size_t chef_quantity_normalize(const char *in, char *out, size_t size) {
+    char text[CHEF_RECIPE_TEXT_MAX * 2];
+    simplify(in, text, sizeof(text));
+
+    // the amount: digits, '.', '/' and the spaces inside "1 1/2"
+    const char *p = text;
+    const char *amount_end = text;
+    while (isdigit((unsigned char)*p) || *p == '.' || *p == '/' || *p == ' ') {
+        if (isdigit((unsigned char)*p)) {
+            amount_end = p + 1;
+        }
+        p++;
+    }
+
+    size_t len = 0;
+    out[0] = '\0';
+    if (amount_end != text && isdigit((unsigned char)text[0])) {
+        p = amount_end;
+        while (*p == ' ') {
+            p++;
+        }
+        const char *word = p;
+        while (isalpha((unsigned char)*p)) {
+            p++;
+        }
+        size_t word_len = p - word;
+        if (*p == '.') {
+            p++;    // "tbsp."
+        }
+        bool ends = *p == '\0' || *p == ' ' || *p == ',' || *p == ')';
+        for (size_t i = 0; word_len && ends && i < ARRAY_SIZE(units); i++) {
+            if (strlen(units[i].name) == word_len && strncasecmp(word, units[i].name, word_len) == 0) {
+                put(out, size, &len, text, amount_end - text);
+                if (!units[i].attached) {
+                    put(out, size, &len, " ", 1);
+                }
+                put(out, size, &len, units[i].unit, strlen(units[i].unit));
+                put(out, size, &len, p, strlen(p));
+                return len;
+            }
+        }
+    }
+    put(out, size, &len, text, strlen(text));
+    return len;
+}
+
+static void issue(chef_recipe_report_t *report, bool error, int index, const cJSON *recipe,
+                  const char *fmt, ...) {
+    if (error) {
+        report->errors++;
+    } else {
+        report->warnings++;
+    }
+    if (!report->log) {
+        return;
+    }
+
+    const cJSON *name = cJSON_GetObjectItemCaseSensitive(recipe, "name");
+    fprintf(report->log, "recipe %d", index);
+    if (cJSON_IsString(name)) {
+        fprintf(report->log, " (%s)", name->valuestring);
+    }
+    fprintf(report->log, ": %s: ", error ? "error" : "warning");
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(report->log, fmt, args);
+    va_end(args);
+    fputc('\n', report->log);
+}
+
+static bool is_blank(const char *s) {
+    while (isspace((unsigned char)*s)) {
+        s++;
+    }
+    return *s == '\0';
+}
+
+// A required, non-blank string of at most max bytes
+static bool check_text(const cJSON *item, size_t max) {
+    return cJSON_IsString(item) && !is_blank(item->valuestring) && strlen(item->valuestring) <= max;
+}
+
+static void check_ingredients(cJSON *recipe, int index, chef_recipe_report_t *report) {
+    cJSON *ingredients = cJSON_GetObjectItemCaseSensitive(recipe, "ingredients");
+    if (!cJSON_IsArray(ingredients)) {
+        issue(report, true, index, recipe, "\"ingredients\" must be an array");
+        return;
+    }
+    if (cJSON_GetArraySize(ingredients) > CHEF_RECIPE_MAX_INGREDIENTS) {
+        issue(report, true, index, recipe, "%d ingredients, at most %d fit",
+              cJSON_GetArraySize(ingredients), CHEF_RECIPE_MAX_INGREDIENTS);
+    }
+
+    int i = 0;
+    cJSON *ingredient;
+    cJSON_ArrayForEach(ingredient, ingredients) {
+        cJSON *item = cJSON_GetObjectItemCaseSensitive(ingredient, "item");
+        cJSON *quantity = cJSON_GetObjectItemCaseSensitive(ingredient, "quantity");
+        if (!cJSON_IsObject(ingredient)) {
+            issue(report, true, index, recipe, "ingredient %d is not an object", i);
+        } else if (!check_text(item, CHEF_RECIPE_TEXT_MAX)) {
+            issue(report, true, index, recipe, "ingredient %d: \"item\" must be a string of 1 to %d bytes",
+                  i, CHEF_RECIPE_TEXT_MAX);
+        } else if (!check_text(quantity, CHEF_RECIPE_TEXT_MAX)) {
+            issue(report, true, index, recipe, "ingredient %d: \"quantity\" must be a string of 1 to %d bytes",
+                  i, CHEF_RECIPE_TEXT_MAX);
+        } else {
+            char normal[CHEF_RECIPE_TEXT_MAX + 1];
+            chef_quantity_normalize(quantity->valuestring, normal, sizeof(normal));
+            if (strcmp(normal, quantity->valuestring) != 0) {
+                cJSON_ReplaceItemInObjectCaseSensitive(ingredient, "quantity", cJSON_CreateString(normal));
+            }
+        }
+        i++;
+    }
+}
+
+static void check_instructions(cJSON *recipe, int index, chef_recipe_report_t *report) {
+    cJSON *instructions = cJSON_GetObjectItemCaseSensitive(recipe, "instructions");
+    if (!cJSON_IsArray(instructions)) {
+        issue(report, true, index, recipe, "\"instructions\" must be an array");
+        return;
+    }
+    if (cJSON_GetArraySize(instructions) > CHEF_RECIPE_MAX_STEPS) {
+        issue(report, true, index, recipe, "%d steps, at most %d fit",
+              cJSON_GetArraySize(instructions), CHEF_RECIPE_MAX_STEPS);
+    }
+
+    int i = 0;
+    cJSON *step;
+    cJSON_ArrayForEach(step, instructions) {
+        if (!check_text(step, CHEF_RECIPE_TEXT_MAX)) {
+            issue(report, true, index, recipe, "step %d must be a string of 1 to %d bytes",
+                  i, CHEF_RECIPE_TEXT_MAX);
+        }
+        i++;
+    }
+}
+
+bool chef_recipe_check(cJSON *recipe, int index, chef_recipe_report_t *report) {
+    int errors = report->errors;
+    if (!cJSON_IsObject(recipe)) {
+        issue(report, true, index, NULL, "not an object");
+        return false;
+    }
+
+    cJSON *member;
+    cJSON_ArrayForEach(member, recipe) {
+        if (strcmp(member->string, "name") != 0 && strcmp(member->string, "ingredients") != 0 &&
+            strcmp(member->string, "instructions") != 0) {
+            issue(report, false, index, recipe, "unknown member \"%s\" is left out", member->string);
+        }
+    }
+
+    if (!check_text(cJSON_GetObjectItemCaseSensitive(recipe, "name"), CHEF_RECIPE_NAME_MAX)) {
+        issue(report, true, index, recipe, "\"name\" must be a string of 1 to %d bytes", CHEF_RECIPE_NAME_MAX);
+    }
+    check_ingredients(recipe, index, report);
+    check_instructions(recipe, index, report);
+    return report->errors == errors;
+}
@@ -0,0 +1,43 @@
+#ifndef CHEF_RECIPE_CHECK_H
+#define CHEF_RECIPE_CHECK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include "cJSON.h"
+
+// The catalog schema, checked on the host before a pack is built:
+//
+//   {"recipes": [ {
+//       "name": "...",                                   1..CHEF_RECIPE_NAME_MAX bytes
+//       "ingredients": [ {"item": "...", "quantity": "..."}, ... ],
+//       "instructions": [ "...", ... ]
+//   }, ... ]}
+//
+// Limits follow what the screens can show: a name fits a recipe button, a step
+// fits the step label buffer.
+
+#define CHEF_RECIPE_NAME_MAX        48
+#define CHEF_RECIPE_TEXT_MAX        200   // item, quantity or step
+#define CHEF_RECIPE_MAX_INGREDIENTS 64
+#define CHEF_RECIPE_MAX_STEPS       64
+
+typedef struct {
+    FILE *log;                  // where problems are described; NULL to only count them
+    int errors;
+    int warnings;
+} chef_recipe_report_t;
+
+// Check one element of the "recipes" array and normalize its quantities in
+// place. index is its position, for messages. Returns false if it has errors;
+// warnings (unknown members) do not fail it.
+bool chef_recipe_check(cJSON *recipe, int index, chef_recipe_report_t *report);
+
+// Write the canonical spelling of a quantity to out: whitespace trimmed and
+// collapsed, unicode fractions spelled out, and the unit after a leading
+// amount reduced to one abbreviation ("200 grams" -> "200g", "2 Tablespoons"
+// -> "2 tbsp"). Anything after the unit is kept as written. Returns the
+// length, truncating to size - 1.
+size_t chef_quantity_normalize(const char *in, char *out, size_t size);
+
+#endif
@@ -1,44 +1,45 @@
 #include "esp_log.h"
-#include "esp_task_wdt.h"
 #include "nvs_flash.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
 #include "chef_network/chef_wifi.h"
 #include "chef_network/chef_client.h"
+#include "chef_pack/chef_pack_store.h"
+#include "chef_pack/chef_catalog.h"
 #include "chef_lvgl/lvgl_setup.h"
+#include "chef_lvgl/chef_render.h"
+#include "chef_lvgl/chef_ui_queue.h"
+#include "chef_lvgl/chef_keypad.h"
 #include "lvgl.h"
 #include "chef_screens/chef_styles.h"
 #include "chef_screens/chef_startup.h"
+#include "chef_screens/chef_screen_manager.h"
 #include "chef_buttons/chef_button.h"
 #include "chef_hx711/HX711.h"
 
 
 static const char *TAG = "Main file";
 
-void lvgl_handler_task(void *pvParameters) {
-    ESP_ERROR_CHECK(esp_task_wdt_add(NULL));
-    while (1) {
-        lv_timer_handler();
-        esp_task_wdt_reset();
-        vTaskDelay(pdMS_TO_TICKS(20));
-    }
-}
-
 void app_main() {
 
     ESP_LOGI(TAG, "Good morning! Device booting up!");
+    // The last synced catalog is usable even if the download below fails
+    chef_pack_store_init();
     initialize_wifi();
     ESP_LOGI(TAG, "WIFI has been successfully initialized");
     fetch_github_json();
     ESP_LOGI(TAG, "Recipes have been fetched");
+    chef_catalog_load(fetch_recipe_pack());
 
     lvgl_init_all();
+    chef_ui_queue_init();
     setup_buttons();
+    chef_keypad_init(chef_screen_nav_handlers);
     chef_init_styles();
-    chef_screen_create_home();
+    chef_screen_show(CHEF_SCREEN_HOME);
     nvs_flash_init();
     
-    xTaskCreatePinnedToCore(lvgl_handler_task, "lvgl_handler", 8192, NULL, 5, NULL, 1);
+    chef_render_start();
 
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(100));
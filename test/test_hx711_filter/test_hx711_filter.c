@@ -0,0 +1,199 @@
+// Host tests for the weight filter: recorded-style traces go through HX711_filter_push with
+// the settings chef_scale_service uses, and the output is checked stage by stage.
+//   pio test -e native -f test_hx711_filter
+#include <unity.h>
+#include "chef_hx711/HX711_filter.h"
+#include "traces.h"
+
+#define COUNT(a) (sizeof(a) / sizeof((a)[0]))
+
+// as in chef_scale_service.c
+#define MEDIAN_SAMPLES		5
+#define EMA_ALPHA			HX711_ALPHA(0.3f)
+#define STABLE_BAND_MG		1000
+#define STABLE_SAMPLES		8
+#define ZERO_TRACK_BAND_MG	500
+#define ZERO_TRACK_STEP_MG	1
+
+static HX711_filter_t filter;
+
+// events seen by run(), in order
+typedef struct
+{
+	HX711_STABLE_EVENT event;
+	int index;
+	int32_t value;
+} event_t;
+
+static event_t events[16];
+static int event_count;
+
+void setUp(void)
+{
+	HX711_filter_init(&filter, MEDIAN_SAMPLES, EMA_ALPHA, STABLE_BAND_MG, STABLE_SAMPLES);
+	HX711_filter_set_zero_tracking(&filter, ZERO_TRACK_BAND_MG, ZERO_TRACK_STEP_MG);
+	event_count = 0;
+}
+
+void tearDown(void)
+{
+}
+
+// push n samples, recording the events; returns the last output
+static HX711_filter_out_t run(const int32_t *trace, int n)
+{
+	HX711_filter_out_t out = { 0 };
+	for (int i = 0; i < n; i++)
+	{
+		out = HX711_filter_push(&filter, trace[i]);
+		if (out.event != eSTABLE_NONE && event_count < (int)COUNT(events))
+			events[event_count++] = (event_t){ out.event, i, out.value };
+	}
+	return out;
+}
+
+static void test_median_drops_single_spikes(void)
+{
+	HX711_median_t m;
+	HX711_median_init(&m, MEDIAN_SAMPLES);
+	for (int i = 0; i < (int)COUNT(trace_spike); i++)
+	{
+		// the knocks are 45-60 g; what gets through is conversion noise only
+		TEST_ASSERT_INT_WITHIN(150, 100000, HX711_median_push(&m, trace_spike[i]));
+	}
+}
+
+static void test_median_window(void)
+{
+	HX711_median_t m;
+	HX711_median_init(&m, 4);	// rounded down to odd
+	TEST_ASSERT_EQUAL_INT(3, m.n);
+	TEST_ASSERT_EQUAL_INT(7, HX711_median_push(&m, 7));
+	TEST_ASSERT_EQUAL_INT(1, HX711_median_push(&m, 1));	// lower middle until the window fills
+	TEST_ASSERT_EQUAL_INT(5, HX711_median_push(&m, 5));
+	TEST_ASSERT_EQUAL_INT(5, HX711_median_push(&m, 900));
+	TEST_ASSERT_EQUAL_INT(5, HX711_median_push(&m, 4));
+}
+
+static void test_spikes_never_unsettle(void)
+{
+	HX711_filter_out_t out = run(trace_spike, COUNT(trace_spike));
+	TEST_ASSERT_EQUAL_INT(1, event_count);
+	TEST_ASSERT_EQUAL_INT(eSTABLE_SETTLED, events[0].event);
+	TEST_ASSERT_LESS_OR_EQUAL(STABLE_SAMPLES + MEDIAN_SAMPLES, events[0].index);
+	TEST_ASSERT_TRUE(out.stable);
+	TEST_ASSERT_INT_WITHIN(50, 100000, out.value);
+}
+
+static void test_ema_converges_without_overshoot(void)
+{
+	HX711_ema_t e;
+	HX711_ema_init(&e, EMA_ALPHA);
+	TEST_ASSERT_EQUAL_INT(0, HX711_ema_push(&e, 0));	// the first sample is taken as is
+
+	// 0.7^13 < 1%: within 1% of a 250 g step after 13 samples, approaching from below
+	int32_t last = 0;
+	for (int i = 1; i <= 13; i++)
+	{
+		int32_t v = HX711_ema_push(&e, 250000);
+		TEST_ASSERT_GREATER_THAN(last, v);
+		TEST_ASSERT_LESS_OR_EQUAL(250000, v);
+		last = v;
+	}
+	TEST_ASSERT_INT_WITHIN(2500, 250000, last);
+
+	// then it stops where a step rounds to nothing: less than 1 / (2 alpha) counts short
+	for (int i = 0; i < 40; i++)
+		last = HX711_ema_push(&e, 250000);
+	TEST_ASSERT_INT_WITHIN(2, 250000, last);
+	TEST_ASSERT_LESS_OR_EQUAL(250000, last);
+}
+
+static void test_pour_loses_and_resettles(void)
+{
+	HX711_filter_out_t out = run(trace_pour, COUNT(trace_pour));
+	TEST_ASSERT_EQUAL_INT(3, event_count);
+
+	// settled on the empty platform
+	TEST_ASSERT_EQUAL_INT(eSTABLE_SETTLED, events[0].event);
+	TEST_ASSERT_LESS_THAN(40, events[0].index);
+	TEST_ASSERT_INT_WITHIN(100, 0, events[0].value);
+
+	// lost within a few samples of the pour starting at sample 40
+	TEST_ASSERT_EQUAL_INT(eSTABLE_LOST, events[1].event);
+	TEST_ASSERT_INT_WITHIN(5, 43, events[1].index);
+
+	// and settled again only once it stopped at sample 140, never during the pour
+	TEST_ASSERT_EQUAL_INT(eSTABLE_SETTLED, events[2].event);
+	TEST_ASSERT_GREATER_OR_EQUAL(140, events[2].index);
+	TEST_ASSERT_LESS_THAN(140 + 30, events[2].index);
+	TEST_ASSERT_INT_WITHIN(STABLE_BAND_MG, 250000, events[2].value);
+
+	TEST_ASSERT_TRUE(out.stable);
+	TEST_ASSERT_INT_WITHIN(100, 250000, out.value);
+}
+
+static void test_set_down_settles_after_ringing(void)
+{
+	HX711_filter_out_t out = run(trace_settle, COUNT(trace_settle));
+	TEST_ASSERT_EQUAL_INT(3, event_count);
+	TEST_ASSERT_EQUAL_INT(eSTABLE_SETTLED, events[0].event);
+	TEST_ASSERT_EQUAL_INT(eSTABLE_LOST, events[1].event);
+	TEST_ASSERT_INT_WITHIN(3, 20, events[1].index);
+
+	// not before the ringing is inside the band, and not long after
+	TEST_ASSERT_EQUAL_INT(eSTABLE_SETTLED, events[2].event);
+	TEST_ASSERT_GREATER_THAN(20 + STABLE_SAMPLES, events[2].index);
+	TEST_ASSERT_LESS_THAN(20 + 50, events[2].index);
+	TEST_ASSERT_INT_WITHIN(STABLE_BAND_MG, 500000, events[2].value);
+
+	TEST_ASSERT_INT_WITHIN(100, 500000, out.value);
+}
+
+static void test_zero_tracking_follows_drift(void)
+{
+	for (int i = 0; i < (int)COUNT(trace_drift); i++)
+	{
+		HX711_filter_out_t out = HX711_filter_push(&filter, trace_drift[i]);
+		TEST_ASSERT_INT_WITHIN(100, 0, out.value);
+	}
+	TEST_ASSERT_TRUE(filter.stable.stable);
+	TEST_ASSERT_INT_WITHIN(60, 300, filter.zero.zero);
+}
+
+static void test_zero_tracking_leaves_loads_alone(void)
+{
+	// 100 g is far outside the tracking band: the zero never moves
+	run(trace_spike, COUNT(trace_spike));
+	TEST_ASSERT_EQUAL_INT(0, filter.zero.zero);
+}
+
+static void test_zero_tracking_is_rate_limited(void)
+{
+	// 400 mg is inside the band, but is tracked away no faster than ZERO_TRACK_STEP_MG per sample
+	for (int i = 0; i < 50; i++)
+		HX711_filter_push(&filter, 0);
+	int32_t before = filter.zero.zero;
+	for (int i = 0; i < 100; i++)
+	{
+		HX711_filter_out_t out = HX711_filter_push(&filter, 400);
+		TEST_ASSERT_LESS_OR_EQUAL(ZERO_TRACK_STEP_MG * (i + 1), filter.zero.zero - before);
+		TEST_ASSERT_GREATER_OR_EQUAL(0, out.value);
+	}
+	TEST_ASSERT_LESS_OR_EQUAL(100, filter.zero.zero - before);
+}
+
+int main(void)
+{
+	UNITY_BEGIN();
+	RUN_TEST(test_median_drops_single_spikes);
+	RUN_TEST(test_median_window);
+	RUN_TEST(test_spikes_never_unsettle);
+	RUN_TEST(test_ema_converges_without_overshoot);
+	RUN_TEST(test_pour_loses_and_resettles);
+	RUN_TEST(test_set_down_settles_after_ringing);
+	RUN_TEST(test_zero_tracking_follows_drift);
+	RUN_TEST(test_zero_tracking_leaves_loads_alone);
+	RUN_TEST(test_zero_tracking_is_rate_limited);
+	return UNITY_END();
+}
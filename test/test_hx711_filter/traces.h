@@ -0,0 +1,196 @@
+#ifndef TRACES_H
+#define TRACES_H
+
+#include <stdint.h>
+
+// Raw weight traces in mg, one value per conversion at 10 SPS, as HX711_sample_t.weight_mg
+// delivers them. Generated once, with about 40 mg rms of conversion noise, and kept here so
+// every run sees the same samples.
+
+// 100 g at rest with four single-sample knocks of -45 g and +60 g (samples 17, 52,
+// 77 and 103)
+static const int32_t trace_spike[] = {
+	99970, 99974, 99974, 100013, 100013, 99975, 99993, 100057, 100018, 99996,
+	100003, 100001, 99948, 100025, 100045, 99979, 100009, 160023, 100007, 99985,
+	99960, 100020, 100022, 100033, 99989, 100048, 100008, 100023, 100042, 100047,
+	100036, 99987, 100004, 99926, 99956, 99991, 100045, 99930, 99973, 100018,
+	100055, 100006, 100035, 100020, 99983, 100041, 99960, 100018, 100014, 100049,
+	100021, 99958, 54999, 99927, 100037, 99991, 100000, 100027, 100034, 100055,
+	100048, 100001, 100001, 99957, 100052, 99969, 100036, 99987, 99961, 100051,
+	99995, 99949, 99962, 100002, 100051, 99951, 100031, 159967, 99939, 100034,
+	100079, 100012, 100031, 100006, 99953, 100005, 99974, 100017, 99990, 99974,
+	100019, 99991, 99958, 100033, 100032, 99946, 99986, 100014, 100069, 100073,
+	100050, 100001, 99990, 160020, 99984, 100018, 100012, 99974, 99965, 99967,
+	100065, 99950, 99968, 100046, 100013, 100004, 99955, 99986, 100024, 99984,
+};
+
+// empty for 40 samples, 250 g poured over the next 100 at about 2.5 g per sample,
+// then left to rest for 80
+static const int32_t trace_pour[] = {
+	-20, -50, 6, 13, 44, -41, 0, -9, -46, 0,
+	12, -38, 40, -22, 42, -42, -55, -42, -54, -19,
+	34, -60, 25, 27, -36, -32, -84, -7, -12, -15,
+	61, 14, -16, -60, 86, 1, -78, 15, -15, 47,
+	2413, 5323, 7292, 9913, 12573, 14462, 18147, 20220, 22601, 24632,
+	27482, 30097, 32603, 35390, 37756, 39693, 42467, 45208, 48004, 50300,
+	52563, 54868, 57263, 60076, 62686, 65470, 67504, 69798, 72383, 75229,
+	77112, 80087, 82704, 85003, 87382, 90112, 92726, 94493, 97117, 100035,
+	102532, 104526, 108058, 109956, 112448, 115358, 117951, 120229, 122522, 125134,
+	127112, 129675, 132101, 135403, 137772, 140066, 142683, 145407, 147564, 150094,
+	152609, 155038, 157364, 159422, 163019, 164169, 167314, 170460, 172611, 174623,
+	177736, 180220, 182592, 184744, 187127, 189886, 192132, 195224, 197078, 199902,
+	202644, 204983, 207491, 210022, 212583, 214561, 217894, 219782, 222655, 224833,
+	227886, 229652, 232038, 234907, 238172, 239604, 242419, 245031, 247871, 249858,
+	249997, 250062, 250045, 250005, 250008, 250003, 249990, 249994, 249948, 250043,
+	250004, 249992, 249955, 249938, 249949, 249967, 249993, 249986, 249973, 249931,
+	250000, 250130, 249980, 249995, 249971, 250057, 249966, 250047, 250014, 250001,
+	249969, 250000, 250033, 249979, 249908, 250074, 249990, 250019, 250011, 249994,
+	250003, 250040, 249928, 250055, 250081, 250021, 250008, 250012, 249993, 249975,
+	249975, 250081, 250024, 249984, 249992, 250088, 249926, 250008, 250000, 249930,
+	250002, 249979, 250029, 249969, 249938, 250059, 250086, 249976, 249958, 250016,
+	250017, 250082, 250037, 249951, 250092, 249947, 250025, 249963, 249996, 249943,
+};
+
+// empty for 20 samples, then a 500 g weight set down, ringing out over the next
+// second or so
+static const int32_t trace_settle[] = {
+	-15, 22, 70, 57, 3, -10, 11, -21, 18, -33,
+	-33, 50, 70, -2, -67, -45, 30, -18, 65, 18,
+	539988, 509027, 475495, 482420, 509538, 516961, 500791, 488212, 494136, 505786,
+	506747, 498965, 494630, 498305, 503108, 502583, 498931, 497679, 499693, 501507,
+	500859, 499401, 499020, 500065, 500672, 500299, 499576, 499637, 500071, 500374,
+	500058, 499819, 499820, 500084, 500153, 500051, 499919, 499957, 500058, 500107,
+	500011, 499932, 500041, 499989, 499961, 500040, 500012, 500005, 500010, 500009,
+	499887, 499931, 500025, 499970, 500061, 499979, 500035, 499959, 499969, 500021,
+	500052, 500043, 500026, 499939, 500013, 499996, 499955, 499996, 500027, 499974,
+	500017, 500050, 500038, 499939, 500018, 500016, 500014, 500047, 500013, 500025,
+	499965, 500017, 499971, 499958, 499961, 499981, 500047, 500033, 500013, 500040,
+	500014, 499948, 499925, 500087, 499998, 499939, 500043, 499956, 500064, 500008,
+};
+
+// empty platform whose baseline creeps up 300 mg over 1200 samples, as it does
+// while the cell warms up
+static const int32_t trace_drift[] = {
+	-10, -55, -19, -118, -22, -19, -24, 30, -21, 27,
+	-47, -17, 3, 32, 51, -63, 1, 13, -1, -7,
+	-8, -36, 13, 95, -4, 38, 33, -22, 0, 34,
+	31, 27, 65, 11, -14, 47, -23, 38, 23, 32,
+	22, -21, 43, 13, -19, 77, 33, 39, 57, -16,
+	19, -6, 21, -8, 62, -17, 36, 81, 28, -1,
+	30, 38, 35, 72, 9, 63, -12, 67, 53, 12,
+	37, -52, 47, -17, 66, 7, 81, 0, 37, 38,
+	21, -1, 40, 36, 36, 53, -69, 26, 44, 93,
+	32, 11, -13, 16, -29, 70, 98, 76, -16, 45,
+	63, 45, -36, 91, 101, 3, -15, 19, -19, 18,
+	52, 0, -115, 35, -39, 23, -8, 78, 52, 70,
+	45, 29, 30, 22, 61, 25, 25, 28, 40, 43,
+	15, 49, 71, 53, 0, 92, 72, 25, -2, 69,
+	1, 39, 14, 9, 5, 15, -2, 54, 35, 15,
+	46, 57, 20, 19, 81, -16, 3, 2, -12, 21,
+	-3, 135, 68, 89, 55, 52, 49, 64, 73, 85,
+	36, 31, -29, 17, 17, 12, -13, 33, 39, 159,
+	32, 5, 51, 27, 67, 73, 27, 0, 22, 32,
+	14, 61, 25, 61, 66, 50, -10, 32, 26, 68,
+	52, 77, -6, 83, -33, 72, 69, 91, 86, 72,
+	87, 11, 130, 104, 36, 68, -14, 13, 96, 134,
+	106, 26, 119, 59, 97, 102, -21, 56, -78, 46,
+	68, 59, 68, 122, 99, -7, 2, 63, 136, 22,
+	125, 65, 157, 61, 80, 79, 104, -55, 36, 30,
+	60, 56, 29, 89, 65, 19, 27, 61, 86, 56,
+	77, 90, -7, 5, 80, 26, 60, 97, 96, 118,
+	-17, 102, 19, 108, 59, 34, 56, 141, 55, 91,
+	118, 46, 76, 98, 95, 44, 73, 61, 102, 80,
+	75, 55, 149, 68, 53, 151, 50, 105, 61, 65,
+	21, 6, 49, 55, 50, 58, 84, 117, 43, 76,
+	60, 58, 122, 91, 58, 70, 114, 30, 128, 136,
+	67, 62, 85, 32, 138, 84, 80, 125, 88, 79,
+	14, 94, 44, 44, 92, 79, 71, 90, 147, 83,
+	103, 53, 110, 35, 107, 79, 124, 133, 145, 139,
+	109, 87, 99, 55, 47, 108, 139, 41, 13, 94,
+	136, 60, 53, 45, 69, 70, 107, 109, 83, 102,
+	105, 75, 108, 27, 107, 72, 50, 50, 58, 71,
+	114, 41, 65, 136, 39, 87, 164, 71, 80, 59,
+	119, 84, 59, 99, 135, 151, 100, 121, 134, 53,
+	104, 68, 115, 81, 132, 82, 107, 96, 111, 101,
+	39, 125, 162, 142, 138, 141, 121, 192, 146, 110,
+	111, 103, 92, 130, 76, 51, 104, 125, 90, 51,
+	58, 206, 212, 112, 202, 186, 92, 101, 50, 94,
+	100, 147, 124, 173, 161, 88, 101, 162, 121, 129,
+	119, 131, 84, 196, 96, 184, 91, 60, 117, 84,
+	119, 162, 96, 84, 33, 114, 150, 206, 114, 160,
+	186, 73, 75, 137, 81, 84, 140, 150, 173, 95,
+	109, 67, 121, 146, 156, 186, 93, 91, 35, 101,
+	60, 123, 193, 89, 161, 158, 138, 141, 102, 57,
+	62, 132, 174, 162, 71, 93, 220, 145, 148, 123,
+	154, 150, 90, 37, 126, 172, 142, 133, 105, 188,
+	175, 158, 99, 106, 135, 118, 108, 134, 85, 107,
+	107, 74, 115, 119, 137, 168, 170, 97, 135, 211,
+	181, 72, 101, 141, 180, 125, 134, 70, 119, 190,
+	197, 186, 113, 100, 64, 53, 157, 228, 109, 114,
+	86, 135, 125, 111, 106, 96, 130, 106, 97, 214,
+	163, 81, 135, 145, 138, 147, 153, 93, 169, 259,
+	175, 153, 161, 192, 150, 143, 146, 182, 120, 214,
+	129, 120, 190, 139, 191, 178, 82, 135, 152, 145,
+	200, 168, 115, 173, 93, 113, 220, 154, 162, 117,
+	129, 36, 169, 234, 116, 180, 147, 198, 156, 170,
+	130, 215, 189, 187, 111, 167, 152, 166, 129, 137,
+	187, 147, 105, 158, 228, 96, 180, 134, 232, 139,
+	137, 190, 130, 149, 197, 197, 141, 176, 224, 179,
+	211, 176, 151, 87, 187, 150, 121, 152, 136, 139,
+	187, 168, 199, 98, 192, 119, 137, 219, 117, 201,
+	136, 131, 138, 130, 172, 115, 93, 224, 199, 190,
+	137, 148, 213, 162, 162, 234, 192, 241, 185, 174,
+	202, 195, 169, 145, 184, 161, 162, 158, 143, 159,
+	234, 183, 172, 169, 136, 185, 193, 143, 138, 155,
+	163, 145, 118, 182, 117, 194, 147, 226, 201, 209,
+	222, 92, 168, 203, 212, 169, 213, 231, 311, 210,
+	208, 158, 228, 157, 226, 178, 190, 163, 192, 180,
+	171, 165, 244, 176, 140, 127, 223, 178, 144, 201,
+	163, 184, 160, 176, 194, 200, 225, 181, 228, 216,
+	142, 246, 168, 205, 214, 214, 203, 157, 278, 217,
+	197, 210, 248, 233, 287, 200, 181, 192, 162, 333,
+	224, 246, 200, 242, 209, 243, 159, 100, 251, 164,
+	185, 183, 163, 246, 219, 251, 232, 266, 174, 172,
+	211, 174, 245, 217, 146, 214, 222, 98, 194, 189,
+	196, 105, 201, 174, 198, 196, 215, 201, 283, 240,
+	214, 152, 201, 210, 192, 119, 108, 219, 247, 161,
+	178, 200, 199, 159, 235, 195, 219, 196, 230, 161,
+	207, 190, 206, 277, 194, 211, 241, 199, 190, 193,
+	226, 238, 148, 194, 259, 272, 114, 237, 269, 222,
+	117, 288, 207, 232, 210, 204, 221, 231, 166, 230,
+	248, 187, 166, 300, 247, 189, 294, 202, 194, 242,
+	227, 184, 223, 207, 259, 217, 228, 287, 211, 157,
+	194, 167, 191, 181, 229, 249, 168, 234, 198, 214,
+	261, 259, 186, 239, 250, 165, 219, 212, 244, 198,
+	242, 217, 183, 235, 310, 276, 197, 285, 218, 265,
+	195, 154, 242, 265, 224, 213, 166, 223, 301, 252,
+	258, 191, 221, 249, 176, 266, 175, 257, 213, 197,
+	262, 193, 228, 206, 305, 186, 245, 212, 184, 195,
+	218, 226, 195, 213, 227, 269, 185, 285, 249, 246,
+	258, 259, 209, 228, 268, 283, 316, 224, 276, 267,
+	199, 273, 210, 225, 226, 226, 214, 264, 289, 275,
+	275, 262, 198, 242, 250, 171, 164, 221, 215, 209,
+	246, 228, 237, 240, 241, 303, 269, 259, 230, 219,
+	245, 295, 262, 223, 275, 323, 218, 236, 246, 193,
+	273, 246, 288, 241, 313, 206, 313, 310, 257, 265,
+	274, 291, 261, 233, 271, 235, 248, 257, 206, 264,
+	225, 291, 286, 254, 250, 255, 271, 250, 208, 280,
+	260, 260, 290, 246, 288, 264, 236, 213, 334, 305,
+	283, 271, 265, 264, 305, 304, 308, 361, 276, 254,
+	381, 262, 219, 229, 211, 315, 218, 296, 256, 213,
+	264, 220, 246, 282, 345, 339, 238, 275, 253, 251,
+	266, 280, 330, 183, 238, 299, 346, 322, 279, 154,
+	245, 250, 360, 293, 242, 244, 243, 311, 251, 294,
+	382, 236, 281, 306, 280, 237, 266, 237, 228, 303,
+	332, 237, 331, 251, 274, 287, 299, 238, 265, 288,
+	272, 205, 276, 233, 207, 309, 304, 277, 208, 277,
+	289, 268, 316, 243, 294, 153, 345, 297, 270, 285,
+	263, 330, 248, 228, 261, 228, 358, 323, 286, 294,
+	294, 240, 253, 345, 304, 294, 280, 281, 226, 337,
+	288, 225, 243, 232, 322, 248, 317, 261, 365, 268,
+	286, 387, 297, 330, 333, 324, 224, 213, 269, 324,
+	291, 245, 267, 301, 321, 294, 299, 281, 235, 275,
+	334, 296, 270, 291, 308, 337, 265, 332, 268, 324,
+};
+
+#endif